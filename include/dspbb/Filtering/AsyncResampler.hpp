@@ -0,0 +1,215 @@
+#pragma once
+
+#include "../Math/DotProduct.hpp"
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalTraits.hpp"
+#include "../Primitives/SignalView.hpp"
+#include "../Utility/TypeTraits.hpp"
+#include "Polyphase.hpp"
+#include "StreamHistory.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+
+namespace dspbb {
+
+enum class eBranchInterpolation {
+	LINEAR,
+	CUBIC,
+};
+
+
+/// <summary> Streaming resampler with an arbitrary ratio that can be changed between or during blocks. </summary>
+/// <remarks> The ratio is the number of input samples per output sample. The prototype filter is split into
+///		a polyphase bank with many branches, and the output is interpolated between the branches nearest to
+///		the exact fractional position, which is the same as interpolating the coefficients. The position is
+///		kept continuously, so changing the ratio does not cause discontinuities. </remarks>
+template <class T, class P = remove_complex_t<T>>
+class AsyncResampler {
+public:
+	AsyncResampler(PolyphaseFilter<P, TIME_DOMAIN> polyphase, double ratio, eBranchInterpolation interpolation = eBranchInterpolation::LINEAR);
+
+	/// <summary> Consumes all of <paramref name="input"/> and writes as many outputs as available. </summary>
+	/// <returns> The number of samples written to <paramref name="output"/>. </returns>
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	size_t process(SignalR&& output, const SignalT& input);
+	/// <summary> An upper bound on the number of outputs after feeding <paramref name="inputSize"/> samples. </summary>
+	size_t max_output_size(size_t inputSize) const;
+	void reset();
+
+	void set_ratio(double ratio);
+	double ratio() const { return m_ratio; }
+	/// <summary> The number of input samples received but not yet passed by the read position. </summary>
+	double buffered() const;
+
+private:
+	using W = remove_complex_t<T>;
+	T branch(int64_t hrIndex) const;
+
+	PolyphaseFilter<P, TIME_DOMAIN> m_polyphase;
+	eBranchInterpolation m_interpolation;
+	double m_ratio;
+	size_t m_history = 0;
+	impl::StreamHistory<T> m_input;
+
+	int64_t m_inputBase = 0;
+	double m_fraction = 0.0;
+};
+
+
+/// <summary> Steers the ratio of an <see cref="AsyncResampler"/> to keep its input buffer at a target fill level. </summary>
+/// <remarks> A proportional-integral loop on the fill level error, measured in samples. The gains give the
+///		relative ratio correction per sample of error, so they depend on how often the controller is updated.
+///		The defaults suit one update per a few hundred samples. </remarks>
+class FillLevelController {
+public:
+	FillLevelController(double nominalRatio,
+						double targetFill,
+						double proportionalGain = 2e-5,
+						double integralGain = 2e-7,
+						double maxDeviation = 1e-3);
+
+	/// <summary> Updates the loop with the current fill level. </summary>
+	/// <returns> The new ratio. </returns>
+	double update(double fillLevel);
+	double ratio() const { return m_ratio; }
+	void reset();
+
+private:
+	double m_nominalRatio;
+	double m_targetFill;
+	double m_proportionalGain;
+	double m_integralGain;
+	double m_maxDeviation;
+	double m_integral = 0.0;
+	double m_ratio;
+};
+
+
+//------------------------------------------------------------------------------
+// AsyncResampler
+//------------------------------------------------------------------------------
+
+template <class T, class P>
+AsyncResampler<T, P>::AsyncResampler(PolyphaseFilter<P, TIME_DOMAIN> polyphase, double ratio, eBranchInterpolation interpolation)
+	: m_polyphase(std::move(polyphase)),
+	  m_interpolation(interpolation),
+	  m_ratio(ratio),
+	  m_history(m_polyphase.size_per_phase() + 1),
+	  m_input(m_history) {
+	assert(ratio > 0.0);
+}
+
+template <class T, class P>
+template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int>>
+size_t AsyncResampler<T, P>::process(SignalR&& output, const SignalT& input) {
+	m_input.append(input);
+
+	const int64_t numPhases = int64_t(m_polyphase.num_phases());
+	const bool cubic = m_interpolation == eBranchInterpolation::CUBIC;
+
+	size_t count = 0;
+	for (; count < output.size(); ++count) {
+		const double phasePosition = m_fraction * double(numPhases);
+		const int64_t phaseIndex = std::min(int64_t(phasePosition), numPhases - 1);
+		const W t = W(phasePosition - double(phaseIndex));
+		const int64_t hrIndex = m_inputBase * numPhases + phaseIndex;
+		if ((hrIndex + (cubic ? 2 : 1)) / numPhases >= m_input.size()) {
+			break;
+		}
+
+		if (cubic) {
+			// Lagrange interpolation through the branches at -1, 0, 1 and 2.
+			const W wm1 = -t * (t - W(1)) * (t - W(2)) / W(6);
+			const W w0 = (t + W(1)) * (t - W(1)) * (t - W(2)) / W(2);
+			const W w1 = -(t + W(1)) * t * (t - W(2)) / W(2);
+			const W w2 = (t + W(1)) * t * (t - W(1)) / W(6);
+			output[count] = branch(hrIndex - 1) * T(wm1) + branch(hrIndex) * T(w0) + branch(hrIndex + 1) * T(w1) + branch(hrIndex + 2) * T(w2);
+		}
+		else {
+			output[count] = branch(hrIndex) * T(W(1) - t) + branch(hrIndex + 1) * T(t);
+		}
+
+		m_fraction += m_ratio;
+		const double whole = std::floor(m_fraction);
+		m_inputBase += int64_t(whole);
+		m_fraction -= whole;
+	}
+
+	m_input.release(m_inputBase - int64_t(m_history));
+	return count;
+}
+
+template <class T, class P>
+size_t AsyncResampler<T, P>::max_output_size(size_t inputSize) const {
+	const double available = std::max(0.0, buffered() + double(inputSize));
+	return size_t(std::ceil(available / m_ratio)) + 1;
+}
+
+template <class T, class P>
+void AsyncResampler<T, P>::reset() {
+	m_input.reset();
+	m_inputBase = 0;
+	m_fraction = 0.0;
+}
+
+template <class T, class P>
+void AsyncResampler<T, P>::set_ratio(double ratio) {
+	assert(ratio > 0.0);
+	m_ratio = ratio;
+}
+
+template <class T, class P>
+double AsyncResampler<T, P>::buffered() const {
+	return double(m_input.size() - m_inputBase) - m_fraction;
+}
+
+template <class T, class P>
+T AsyncResampler<T, P>::branch(int64_t hrIndex) const {
+	// Floor division, the branch before the first sample lies at input index -1.
+	const int64_t numPhases = int64_t(m_polyphase.num_phases());
+	const int64_t inputIndex = (hrIndex >= 0 ? hrIndex : hrIndex - numPhases + 1) / numPhases;
+	const auto phase = m_polyphase[size_t(hrIndex - inputIndex * numPhases)];
+	return T(DotProduct(m_input.window(inputIndex, phase.size()), phase));
+}
+
+
+//------------------------------------------------------------------------------
+// FillLevelController
+//------------------------------------------------------------------------------
+
+inline FillLevelController::FillLevelController(double nominalRatio,
+												 double targetFill,
+												 double proportionalGain,
+												 double integralGain,
+												 double maxDeviation)
+	: m_nominalRatio(nominalRatio),
+	  m_targetFill(targetFill),
+	  m_proportionalGain(proportionalGain),
+	  m_integralGain(integralGain),
+	  m_maxDeviation(maxDeviation),
+	  m_ratio(nominalRatio) {
+	assert(nominalRatio > 0.0);
+	assert(maxDeviation >= 0.0);
+}
+
+inline double FillLevelController::update(double fillLevel) {
+	// A fuller buffer means the input arrives faster than it's consumed, so more input is taken per output.
+	const double error = fillLevel - m_targetFill;
+	if (m_integralGain > 0.0) {
+		const double integralLimit = m_maxDeviation / m_integralGain;
+		m_integral = std::clamp(m_integral + error, -integralLimit, integralLimit);
+	}
+	const double deviation = std::clamp(m_proportionalGain * error + m_integralGain * m_integral, -m_maxDeviation, m_maxDeviation);
+	m_ratio = m_nominalRatio * (1.0 + deviation);
+	return m_ratio;
+}
+
+inline void FillLevelController::reset() {
+	m_integral = 0.0;
+	m_ratio = m_nominalRatio;
+}
+
+} // namespace dspbb
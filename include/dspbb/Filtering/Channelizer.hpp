@@ -0,0 +1,142 @@
+#pragma once
+
+#include "../Math/FFT.hpp"
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalTraits.hpp"
+#include "../Primitives/SignalView.hpp"
+#include "../Utility/TypeTraits.hpp"
+#include "StreamHistory.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <complex>
+
+
+namespace dspbb {
+
+/// <summary> Polyphase filter bank that splits a stream into equally spaced, decimated channels. </summary>
+/// <remarks> Channel k is the input shifted down by k / numChannels cycles per sample, filtered by the
+///		prototype lowpass, and decimated by <paramref name="decimation"/>. A decimation equal to the number of
+///		channels is critically sampled, smaller divisors of it oversample the channels. The prototype is
+///		split into numChannels paths, and each output block takes one pass over the paths and one inverse FFT.
+///		The FFTs of all blocks available in a call are done as a single batch. </remarks>
+template <class T, class P = remove_complex_t<T>>
+class Channelizer {
+	using U = remove_complex_t<T>;
+
+public:
+	template <class SignalU>
+	Channelizer(const SignalU& prototype, size_t numChannels, size_t decimation);
+
+	/// <summary> Consumes all of <paramref name="input"/> and writes as many blocks as available. </summary>
+	/// <param name="outputs"> One signal of complex samples per channel. All channels get the same number of samples. </param>
+	/// <returns> The number of samples written to each channel. </returns>
+	/// <remarks> Blocks that do not fit into the shortest output are produced by the next call. </remarks>
+	template <class Outputs, class SignalT>
+	size_t process(Outputs& outputs, const SignalT& input);
+	/// <summary> An upper bound on the number of samples per channel after feeding <paramref name="inputSize"/> samples. </summary>
+	size_t max_output_size(size_t inputSize) const;
+	void reset();
+
+	size_t num_channels() const { return m_numChannels; }
+	size_t decimation() const { return m_decimation; }
+
+private:
+	Signal<P> m_paths;
+	size_t m_numChannels;
+	size_t m_decimation;
+	impl::StreamHistory<T> m_input;
+	int64_t m_blockCount = 0;
+	Signal<std::complex<U>> m_spectra;
+	Signal<std::complex<U>> m_columns;
+};
+
+
+template <class T, class P>
+template <class SignalU>
+Channelizer<T, P>::Channelizer(const SignalU& prototype, size_t numChannels, size_t decimation)
+	: m_numChannels(numChannels), m_decimation(decimation), m_columns(numChannels) {
+	assert(numChannels > 0);
+	assert(decimation > 0 && numChannels % decimation == 0);
+	assert(prototype.size() > 0);
+
+	// The prototype is padded to whole paths and reversed to line up with the input window.
+	const size_t length = (prototype.size() + numChannels - 1) / numChannels * numChannels;
+	m_paths.resize(length, P(0));
+	for (size_t i = 0; i < prototype.size(); ++i) {
+		m_paths[length - 1 - i] = P(prototype[i]);
+	}
+	m_input = impl::StreamHistory<T>(length - 1);
+}
+
+template <class T, class P>
+template <class Outputs, class SignalT>
+size_t Channelizer<T, P>::process(Outputs& outputs, const SignalT& input) {
+	assert(outputs.size() == m_numChannels);
+	m_input.append(input);
+
+	const int64_t decimation = int64_t(m_decimation);
+	const size_t available = size_t((m_input.size() + decimation - 1) / decimation - m_blockCount);
+	size_t numBlocks = available;
+	for (const auto& output : outputs) {
+		numBlocks = std::min(numBlocks, size_t(output.size()));
+	}
+	if (numBlocks == 0) {
+		return 0;
+	}
+
+	const size_t numChannels = m_numChannels;
+	const size_t length = m_paths.size();
+	if (m_spectra.size() < numBlocks * numChannels) {
+		m_spectra.resize(numBlocks * numChannels);
+	}
+
+	// Block m ends at input sample m * decimation. The paths are summed, then rotated by the phase the
+	// decimation leaves on the channels.
+	for (size_t block = 0; block < numBlocks; ++block) {
+		const int64_t last = (m_blockCount + int64_t(block)) * decimation;
+		const auto window = m_input.window(last, length);
+		std::fill(m_columns.begin(), m_columns.end(), std::complex<U>(0));
+		for (size_t first = 0; first < length; first += numChannels) {
+			for (size_t column = 0; column < numChannels; ++column) {
+				m_columns[column] += window[first + column] * m_paths[first + column];
+			}
+		}
+		const size_t rotation = size_t(last % int64_t(numChannels));
+		auto* spectrum = m_spectra.data() + block * numChannels;
+		for (size_t path = 0; path < numChannels; ++path) {
+			const size_t rotated = path + rotation < numChannels ? path + rotation : path + rotation - numChannels;
+			spectrum[path] = m_columns[numChannels - 1 - rotated];
+		}
+	}
+
+	pocketfft_dspbb::shape_t shape = { numBlocks, numChannels };
+	pocketfft_dspbb::stride_t stride = { ptrdiff_t(numChannels * sizeof(std::complex<U>)), ptrdiff_t(sizeof(std::complex<U>)) };
+	pocketfft_dspbb::shape_t axes = { 1 };
+	pocketfft_dspbb::c2c(shape, stride, stride, axes, pocketfft_dspbb::BACKWARD, m_spectra.data(), m_spectra.data(), U(1));
+
+	for (size_t channel = 0; channel < numChannels; ++channel) {
+		auto& output = outputs[channel];
+		for (size_t block = 0; block < numBlocks; ++block) {
+			output[block] = m_spectra[block * numChannels + channel];
+		}
+	}
+
+	m_blockCount += int64_t(numBlocks);
+	m_input.release(m_blockCount * decimation - int64_t(length) + 1);
+	return numBlocks;
+}
+
+template <class T, class P>
+size_t Channelizer<T, P>::max_output_size(size_t inputSize) const {
+	const int64_t decimation = int64_t(m_decimation);
+	return size_t((m_input.size() + int64_t(inputSize) + decimation - 1) / decimation - m_blockCount);
+}
+
+template <class T, class P>
+void Channelizer<T, P>::reset() {
+	m_input.reset();
+	m_blockCount = 0;
+}
+
+} // namespace dspbb
@@ -0,0 +1,346 @@
+#pragma once
+
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalTraits.hpp"
+#include "../Utility/Numbers.hpp"
+#include "../Utility/TypeTraits.hpp"
+#include "FIR/LeastSquares.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+
+namespace dspbb {
+
+namespace impl {
+
+	// Integer CICs rely on wrap-around, which is only well defined for unsigned types. Float CICs use
+	// compensated moving sums instead of the integrators, whose magnitude would grow without bound.
+	template <class T, class = void>
+	struct cic_accumulator {
+		using type = T;
+	};
+
+	template <class T>
+	struct cic_accumulator<T, std::enable_if_t<std::is_integral_v<T>>> {
+		using type = std::make_unsigned_t<T>;
+	};
+
+	template <class T>
+	using cic_accumulator_t = typename cic_accumulator<T>::type;
+
+
+	template <class T>
+	class CicIntegrators {
+	public:
+		explicit CicIntegrators(size_t stages) : m_state(stages, T(0)) {}
+		T operator()(T x) {
+			for (auto& state : m_state) {
+				x = state += x;
+			}
+			return x;
+		}
+		void reset() { std::fill(m_state.begin(), m_state.end(), T(0)); }
+
+	private:
+		std::vector<T> m_state;
+	};
+
+
+	template <class T>
+	class CicCombs {
+	public:
+		CicCombs(size_t stages, size_t delay) : m_delay(delay), m_state(stages * delay, T(0)) {}
+		T operator()(T x) {
+			for (size_t stage = 0; stage < m_state.size(); stage += m_delay) {
+				T& delayed = m_state[stage + m_position];
+				const T difference = x - delayed;
+				delayed = x;
+				x = difference;
+			}
+			m_position = m_position + 1 == m_delay ? 0 : m_position + 1;
+			return x;
+		}
+		void reset() {
+			std::fill(m_state.begin(), m_state.end(), T(0));
+			m_position = 0;
+		}
+
+	private:
+		size_t m_delay;
+		size_t m_position = 0;
+		std::vector<T> m_state;
+	};
+
+
+	// Cascade of moving sums, the same response as integrators followed by combs at the same rate.
+	// A running sum keeps every rounding error that enters it, so each stage carries a Kahan compensation
+	// term, which keeps the error bounded instead of drifting over long streams.
+	template <class T>
+	class CicMovingSums {
+	public:
+		CicMovingSums(size_t stages, size_t length)
+			: m_length(length), m_sums(stages, T(0)), m_compensations(stages, T(0)), m_state(stages * length, T(0)) {}
+		T operator()(T x) {
+			for (size_t stage = 0; stage < m_sums.size(); ++stage) {
+				T& delayed = m_state[stage * m_length + m_position];
+				add(stage, x);
+				add(stage, -delayed);
+				delayed = x;
+				x = m_sums[stage];
+			}
+			m_position = m_position + 1 == m_length ? 0 : m_position + 1;
+			return x;
+		}
+		void reset() {
+			std::fill(m_sums.begin(), m_sums.end(), T(0));
+			std::fill(m_compensations.begin(), m_compensations.end(), T(0));
+			std::fill(m_state.begin(), m_state.end(), T(0));
+			m_position = 0;
+		}
+
+	private:
+		void add(size_t stage, T value) {
+			const T corrected = value - m_compensations[stage];
+			const T updated = m_sums[stage] + corrected;
+			m_compensations[stage] = (updated - m_sums[stage]) - corrected;
+			m_sums[stage] = updated;
+		}
+
+		size_t m_length;
+		size_t m_position = 0;
+		std::vector<T> m_sums;
+		std::vector<T> m_compensations;
+		std::vector<T> m_state;
+	};
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// Decimator
+//------------------------------------------------------------------------------
+
+/// <summary> Cascaded integrator-comb decimator that needs no multiplications. </summary>
+/// <remarks> The output is the input filtered by <paramref name="stages"/> moving sums of length rate * delay,
+///		keeping every rate-th sample starting with the first. The output is not normalized, its DC gain is
+///		<see cref="gain"/>. Integer types must be wide enough for the output, the intermediate values may
+///		overflow. </remarks>
+template <class T>
+class CicDecimator {
+	static_assert(std::is_integral_v<T> || std::is_floating_point_v<remove_complex_t<T>>);
+
+public:
+	CicDecimator(size_t rate, size_t stages, size_t delay = 1);
+
+	/// <summary> Consumes all of <paramref name="input"/>. </summary>
+	/// <returns> The number of samples written to <paramref name="output"/>. </returns>
+	/// <remarks> The <paramref name="output"/> must hold at least <see cref="max_output_size"/> samples. </remarks>
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	size_t process(SignalR&& output, const SignalT& input);
+	size_t max_output_size(size_t inputSize) const;
+	void reset();
+
+	size_t rate() const { return m_rate; }
+	size_t stages() const { return m_stages; }
+	size_t delay() const { return m_delay; }
+	double gain() const { return std::pow(double(m_rate * m_delay), double(m_stages)); }
+
+private:
+	using Acc = impl::cic_accumulator_t<T>;
+	static constexpr bool isRecursive = std::is_integral_v<T>;
+
+	size_t m_rate;
+	size_t m_stages;
+	size_t m_delay;
+	size_t m_phase = 0;
+	impl::CicIntegrators<Acc> m_integrators;
+	impl::CicCombs<Acc> m_combs;
+	impl::CicMovingSums<Acc> m_sums;
+};
+
+
+template <class T>
+CicDecimator<T>::CicDecimator(size_t rate, size_t stages, size_t delay)
+	: m_rate(rate),
+	  m_stages(stages),
+	  m_delay(delay),
+	  m_integrators(isRecursive ? stages : 0),
+	  m_combs(isRecursive ? stages : 0, delay),
+	  m_sums(isRecursive ? 0 : stages, rate * delay) {
+	assert(rate > 0);
+	assert(stages > 0);
+	assert(delay > 0);
+}
+
+template <class T>
+template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int>>
+size_t CicDecimator<T>::process(SignalR&& output, const SignalT& input) {
+	assert(output.size() >= max_output_size(input.size()));
+
+	size_t count = 0;
+	for (const auto& sample : input) {
+		if constexpr (isRecursive) {
+			const Acc integrated = m_integrators(Acc(sample));
+			if (m_phase == 0) {
+				output[count++] = T(m_combs(integrated));
+			}
+		}
+		else {
+			const Acc summed = m_sums(Acc(sample));
+			if (m_phase == 0) {
+				output[count++] = T(summed);
+			}
+		}
+		m_phase = m_phase + 1 == m_rate ? 0 : m_phase + 1;
+	}
+	return count;
+}
+
+template <class T>
+size_t CicDecimator<T>::max_output_size(size_t inputSize) const {
+	const size_t untilNext = m_phase == 0 ? 0 : m_rate - m_phase;
+	return inputSize > untilNext ? (inputSize - untilNext + m_rate - 1) / m_rate : 0;
+}
+
+template <class T>
+void CicDecimator<T>::reset() {
+	m_integrators.reset();
+	m_combs.reset();
+	m_sums.reset();
+	m_phase = 0;
+}
+
+
+//------------------------------------------------------------------------------
+// Interpolator
+//------------------------------------------------------------------------------
+
+/// <summary> Cascaded integrator-comb interpolator that needs no multiplications. </summary>
+/// <remarks> The output is the zero-stuffed input filtered by <paramref name="stages"/> moving sums of length
+///		rate * delay, and its DC gain is <see cref="gain"/>. Integer types must be wide enough for the output,
+///		the intermediate values may overflow. </remarks>
+template <class T>
+class CicInterpolator {
+	static_assert(std::is_integral_v<T> || std::is_floating_point_v<remove_complex_t<T>>);
+
+public:
+	CicInterpolator(size_t rate, size_t stages, size_t delay = 1);
+
+	/// <summary> Consumes all of <paramref name="input"/> and writes rate samples for each input sample. </summary>
+	/// <returns> The number of samples written to <paramref name="output"/>. </returns>
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	size_t process(SignalR&& output, const SignalT& input);
+	size_t max_output_size(size_t inputSize) const { return inputSize * m_rate; }
+	void reset();
+
+	size_t rate() const { return m_rate; }
+	size_t stages() const { return m_stages; }
+	size_t delay() const { return m_delay; }
+	double gain() const { return std::pow(double(m_rate * m_delay), double(m_stages)) / double(m_rate); }
+
+private:
+	using Acc = impl::cic_accumulator_t<T>;
+	static constexpr bool isRecursive = std::is_integral_v<T>;
+
+	size_t m_rate;
+	size_t m_stages;
+	size_t m_delay;
+	impl::CicIntegrators<Acc> m_integrators;
+	impl::CicCombs<Acc> m_combs;
+	impl::CicMovingSums<Acc> m_sums;
+};
+
+
+template <class T>
+CicInterpolator<T>::CicInterpolator(size_t rate, size_t stages, size_t delay)
+	: m_rate(rate),
+	  m_stages(stages),
+	  m_delay(delay),
+	  m_integrators(isRecursive ? stages : 0),
+	  m_combs(isRecursive ? stages : 0, delay),
+	  m_sums(isRecursive ? 0 : stages, rate * delay) {
+	assert(rate > 0);
+	assert(stages > 0);
+	assert(delay > 0);
+}
+
+template <class T>
+template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int>>
+size_t CicInterpolator<T>::process(SignalR&& output, const SignalT& input) {
+	assert(output.size() >= max_output_size(input.size()));
+
+	auto outputIt = output.begin();
+	for (const auto& sample : input) {
+		if constexpr (isRecursive) {
+			*outputIt++ = T(m_integrators(m_combs(Acc(sample))));
+			for (size_t i = 1; i < m_rate; ++i) {
+				*outputIt++ = T(m_integrators(Acc(0)));
+			}
+		}
+		else {
+			*outputIt++ = T(m_sums(Acc(sample)));
+			for (size_t i = 1; i < m_rate; ++i) {
+				*outputIt++ = T(m_sums(Acc(0)));
+			}
+		}
+	}
+	return input.size() * m_rate;
+}
+
+template <class T>
+void CicInterpolator<T>::reset() {
+	m_integrators.reset();
+	m_combs.reset();
+	m_sums.reset();
+}
+
+
+//------------------------------------------------------------------------------
+// Compensation
+//------------------------------------------------------------------------------
+
+/// <summary> The amplitude response of a CIC filter normalized to unity DC gain. </summary>
+/// <param name="frequency"> Normalized to the Nyquist frequency of the low rate side. </param>
+template <class T>
+T CicResponse(T frequency, size_t rate, size_t stages, size_t delay = 1) {
+	if (frequency == T(0)) {
+		return T(1);
+	}
+	const T length = T(rate * delay);
+	const T x = pi_v<T> * frequency / T(2 * rate);
+	const T response = std::sin(length * x) / (length * std::sin(x));
+	return std::pow(std::abs(response), T(stages));
+}
+
+
+/// <summary> Designs a least-squares FIR at the low rate that flattens the passband droop of a CIC filter. </summary>
+/// <param name="passbandEdge"> The response is the inverse of the CIC's below this frequency. </param>
+/// <param name="stopbandEdge"> The response is zero above this frequency. </param>
+/// <remarks> Frequencies are normalized to the Nyquist frequency of the low rate side. The filter goes after a
+///		decimator or before an interpolator. It does not include the CIC's gain. </remarks>
+template <class SignalR, class U, std::enable_if_t<is_mutable_signal_v<SignalR>, int> = 0>
+void DesignCicCompensation(SignalR&& out, size_t rate, size_t stages, size_t delay, U passbandEdge, U stopbandEdge) {
+	assert(out.size() % 2 == 1);
+	assert(0 < passbandEdge && passbandEdge < stopbandEdge && stopbandEdge <= 1);
+	const auto response = [=](auto f) {
+		using F = std::decay_t<decltype(f)>;
+		return f <= F(passbandEdge) ? F(1) / CicResponse(f, rate, stages, delay) : F(0);
+	};
+	const auto weight = [=](auto f) {
+		using F = std::decay_t<decltype(f)>;
+		return F(passbandEdge) < f && f < F(stopbandEdge) ? F(0) : F(1);
+	};
+	fir::KernelLeastSquares(out, response, weight);
+}
+
+template <class T, eSignalDomain Domain, class U>
+auto DesignCicCompensation(size_t taps, size_t rate, size_t stages, size_t delay, U passbandEdge, U stopbandEdge) {
+	BasicSignal<T, Domain> out(taps);
+	DesignCicCompensation(out, rate, stages, delay, passbandEdge, stopbandEdge);
+	return out;
+}
+
+} // namespace dspbb
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "../Math/Convolution.hpp"
+#include "../Math/DotProduct.hpp"
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalTraits.hpp"
+#include "../Primitives/SignalView.hpp"
+#include "../Utility/TypeTraits.hpp"
+#include "StreamHistory.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+
+namespace dspbb {
+
+//------------------------------------------------------------------------------
+// Utilities
+//------------------------------------------------------------------------------
+
+/// <summary> The number of outputs of <see cref="DecimatingFir"/>, the same as decimating the full convolution. </summary>
+constexpr size_t DecimatingFirLength(size_t inputSize, size_t filterSize, size_t rate) {
+	return (ConvolutionLength(inputSize, filterSize, CONV_FULL) + rate - 1) / rate;
+}
+
+
+namespace impl {
+	// Input phase p holds x[i * rate - p], and it is filtered by h[j * rate + p].
+	inline size_t DecimatingPhaseSize(size_t size, size_t rate, size_t phase) {
+		return size + phase == 0 ? 0 : (size - 1 + phase) / rate + 1;
+	}
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// Batch
+//------------------------------------------------------------------------------
+
+/// <summary> Filters <paramref name="input"/> and keeps every <paramref name="rate"/>-th sample of the full
+///		convolution, starting with the first. </summary>
+/// <remarks> The input is split into <paramref name="rate"/> phases, and each is convolved with the matching phase
+///		of the filter at the low rate, so only the kept outputs are computed. </remarks>
+template <class SignalR, class SignalT, class SignalU, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT, SignalU>, int> = 0>
+void DecimatingFir(SignalR&& output, const SignalT& input, const SignalU& filter, size_t rate) {
+	assert(rate > 0);
+	assert(output.size() <= DecimatingFirLength(input.size(), filter.size(), rate));
+
+	using T = typename signal_traits<std::decay_t<SignalT>>::type;
+	using U = typename signal_traits<std::decay_t<SignalU>>::type;
+	using R = typename signal_traits<std::decay_t<SignalR>>::type;
+	constexpr auto Domain = signal_traits<std::decay_t<SignalR>>::domain;
+
+	std::fill(output.begin(), output.end(), R(0));
+	BasicSignal<T, Domain> inputPhase;
+	BasicSignal<U, Domain> filterPhase;
+	for (size_t phase = 0; phase < rate && phase < filter.size(); ++phase) {
+		inputPhase.resize(impl::DecimatingPhaseSize(input.size(), rate, phase));
+		for (size_t i = 0; i < inputPhase.size(); ++i) {
+			inputPhase[i] = i * rate >= phase ? input[i * rate - phase] : T(0);
+		}
+		filterPhase.resize((filter.size() - 1 - phase) / rate + 1);
+		for (size_t j = 0; j < filterPhase.size(); ++j) {
+			filterPhase[j] = filter[j * rate + phase];
+		}
+		const size_t length = std::min(output.size(), ConvolutionLength(inputPhase.size(), filterPhase.size(), CONV_FULL));
+		Convolution(AsView(output).subsignal(0, length), inputPhase, filterPhase, 0, false);
+	}
+}
+
+template <class SignalT, class SignalU, std::enable_if_t<is_same_domain_v<SignalT, SignalU>, int> = 0>
+auto DecimatingFir(const SignalT& input, const SignalU& filter, size_t rate) {
+	using T = typename signal_traits<std::decay_t<SignalT>>::type;
+	using U = typename signal_traits<std::decay_t<SignalU>>::type;
+	using R = multiplies_result_t<T, U>;
+	constexpr auto Domain = signal_traits<std::decay_t<SignalT>>::domain;
+
+	BasicSignal<R, Domain> output(DecimatingFirLength(input.size(), filter.size(), rate));
+	DecimatingFir(output, input, filter, rate);
+	return output;
+}
+
+
+//------------------------------------------------------------------------------
+// Streaming
+//------------------------------------------------------------------------------
+
+/// <summary> Stateful version of <see cref="DecimatingFir"/> that accepts blocks of any size. </summary>
+/// <remarks> Incoming samples are dealt to the input phases by a commutator that keeps its position across
+///		blocks. An output is computed when the sample at its decimated position arrives. </remarks>
+template <class T, class P = remove_complex_t<T>>
+class StreamingDecimatingFir {
+public:
+	template <class SignalU>
+	StreamingDecimatingFir(const SignalU& filter, size_t rate);
+
+	/// <summary> Consumes all of <paramref name="input"/> and writes as many outputs as available. </summary>
+	/// <returns> The number of samples written to <paramref name="output"/>. </returns>
+	/// <remarks> Output samples that do not fit are produced by the next call. </remarks>
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	size_t process(SignalR&& output, const SignalT& input);
+	/// <summary> An upper bound on the number of outputs after feeding <paramref name="inputSize"/> samples. </summary>
+	size_t max_output_size(size_t inputSize) const;
+	void reset();
+
+	size_t rate() const { return m_phases.size(); }
+
+private:
+	struct Phase {
+		Signal<P> filter;
+		impl::StreamHistory<T> input;
+		Signal<T> incoming;
+	};
+
+	std::vector<Phase> m_phases;
+	std::vector<size_t> m_counts;
+	int64_t m_inputCount = 0;
+	int64_t m_outputCount = 0;
+};
+
+
+template <class T, class P>
+template <class SignalU>
+StreamingDecimatingFir<T, P>::StreamingDecimatingFir(const SignalU& filter, size_t rate) {
+	assert(rate > 0);
+	assert(filter.size() > 0);
+	m_phases.resize(rate);
+	m_counts.resize(rate);
+	for (size_t phase = 0; phase < rate; ++phase) {
+		// Filter phases are stored reversed so that they line up with the input windows.
+		const size_t size = phase < filter.size() ? (filter.size() - 1 - phase) / rate + 1 : 0;
+		m_phases[phase].filter.resize(size);
+		for (size_t j = 0; j < size; ++j) {
+			m_phases[phase].filter[size - 1 - j] = P(filter[j * rate + phase]);
+		}
+		m_phases[phase].input = impl::StreamHistory<T>(size > 0 ? size - 1 : 0);
+	}
+	reset();
+}
+
+template <class T, class P>
+template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int>>
+size_t StreamingDecimatingFir<T, P>::process(SignalR&& output, const SignalT& input) {
+	const size_t rate = m_phases.size();
+
+	// Deal the samples to the phases, sample n goes to phase -n mod rate.
+	for (auto& phase : m_phases) {
+		if (phase.incoming.size() < input.size() / rate + 1) {
+			phase.incoming.resize(input.size() / rate + 1);
+		}
+	}
+	std::fill(m_counts.begin(), m_counts.end(), size_t(0));
+	size_t phaseIndex = (rate - size_t(m_inputCount % int64_t(rate))) % rate;
+	for (const auto& sample : input) {
+		m_phases[phaseIndex].incoming[m_counts[phaseIndex]++] = sample;
+		phaseIndex = phaseIndex == 0 ? rate - 1 : phaseIndex - 1;
+	}
+	for (size_t i = 0; i < rate; ++i) {
+		m_phases[i].input.append(AsConstView(m_phases[i].incoming).subsignal(0, m_counts[i]));
+	}
+	m_inputCount += int64_t(input.size());
+
+	// Output i is complete when phase 0 has received x[i * rate].
+	size_t count = 0;
+	for (; count < output.size() && m_outputCount < m_phases[0].input.size(); ++count, ++m_outputCount) {
+		T sum = T(0);
+		for (const auto& phase : m_phases) {
+			if (!phase.filter.empty()) {
+				sum += T(DotProduct(phase.input.window(m_outputCount, phase.filter.size()), phase.filter));
+			}
+		}
+		output[count] = sum;
+	}
+
+	for (auto& phase : m_phases) {
+		phase.input.release(m_outputCount - int64_t(phase.filter.size()));
+	}
+	return count;
+}
+
+template <class T, class P>
+size_t StreamingDecimatingFir<T, P>::max_output_size(size_t inputSize) const {
+	const int64_t rate = int64_t(m_phases.size());
+	const int64_t available = (m_inputCount + int64_t(inputSize) + rate - 1) / rate;
+	return size_t(available - m_outputCount);
+}
+
+template <class T, class P>
+void StreamingDecimatingFir<T, P>::reset() {
+	for (size_t i = 0; i < m_phases.size(); ++i) {
+		m_phases[i].input.reset();
+		// Phase p starts with x[-p], which is before the input.
+		if (i != 0) {
+			const T zero = T(0);
+			m_phases[i].input.append(BasicSignalView<const T, TIME_DOMAIN>(&zero, 1));
+		}
+	}
+	m_inputCount = 0;
+	m_outputCount = 0;
+}
+
+} // namespace dspbb
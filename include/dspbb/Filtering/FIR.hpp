@@ -3,6 +3,7 @@
 #include "FIR/BandTransforms.hpp"
 #include "FIR/Descs.hpp"
 #include "FIR/Filter.hpp"
+#include "FIR/FixedFir.hpp"
 #include "FIR/LeastSquares.hpp"
 #include "FIR/Windowed.hpp"
 #include "FilterUtility.hpp"
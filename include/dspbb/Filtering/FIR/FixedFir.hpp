@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <utility>
+
+
+namespace dspbb {
+
+/// <summary> FIR filter with the number of taps fixed at compile time. </summary>
+/// <remarks> Coefficients follow the convolution convention of <see cref="Filter"/>: the first tap multiplies the newest sample.
+///		The filter is a literal type, so coefficients and whole filters can be constexpr, and the per-sample
+///		loops are fully unrolled. </remarks>
+template <class T, size_t Taps>
+class FixedFir {
+	static_assert(Taps > 0);
+
+public:
+	constexpr FixedFir() = default;
+	constexpr explicit FixedFir(const std::array<T, Taps>& coefficients) : m_coefficients(coefficients) {}
+	template <class SignalU>
+	explicit FixedFir(const SignalU& filter);
+
+	constexpr void reset();
+	static constexpr size_t size() { return Taps; }
+	constexpr const std::array<T, Taps>& coefficients() const { return m_coefficients; }
+
+	constexpr T feed(const T& input);
+	template <class InIter, class OutIter>
+	constexpr void feed(InIter first, InIter last, OutIter outFirst);
+
+private:
+	template <size_t... Indices>
+	constexpr T Feed(const T& input, std::index_sequence<Indices...>);
+	template <size_t Index>
+	constexpr void Shift(const T& input);
+
+	std::array<T, Taps> m_coefficients = {};
+	std::array<T, Taps> m_history = {};
+};
+
+
+template <class T, size_t Taps>
+template <class SignalU>
+FixedFir<T, Taps>::FixedFir(const SignalU& filter) {
+	assert(filter.size() == Taps);
+	for (size_t i = 0; i < Taps; ++i) {
+		m_coefficients[i] = T(filter[i]);
+	}
+}
+
+template <class T, size_t Taps>
+constexpr void FixedFir<T, Taps>::reset() {
+	m_history = {};
+}
+
+template <class T, size_t Taps>
+constexpr T FixedFir<T, Taps>::feed(const T& input) {
+	return Feed(input, std::make_index_sequence<Taps>{});
+}
+
+template <class T, size_t Taps>
+template <class InIter, class OutIter>
+constexpr void FixedFir<T, Taps>::feed(InIter first, InIter last, OutIter outFirst) {
+	for (; first != last; ++first, ++outFirst) {
+		*outFirst = feed(*first);
+	}
+}
+
+template <class T, size_t Taps>
+template <size_t... Indices>
+constexpr T FixedFir<T, Taps>::Feed(const T& input, std::index_sequence<Indices...>) {
+	// The history is shifted by one, newest sample first, so that m_history[i] pairs with tap i.
+	(Shift<Taps - 1 - Indices>(input), ...);
+	return ((m_coefficients[Indices] * m_history[Indices]) + ...);
+}
+
+template <class T, size_t Taps>
+template <size_t Index>
+constexpr void FixedFir<T, Taps>::Shift(const T& input) {
+	if constexpr (Index == 0) {
+		m_history[0] = input;
+	}
+	else {
+		m_history[Index] = m_history[Index - 1];
+	}
+}
+
+} // namespace dspbb
@@ -0,0 +1,247 @@
+#pragma once
+
+#include "../Math/DotProduct.hpp"
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalTraits.hpp"
+#include "../Primitives/SignalView.hpp"
+#include "../Utility/TypeTraits.hpp"
+#include "StreamHistory.hpp"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+
+namespace dspbb {
+
+//------------------------------------------------------------------------------
+// Filter
+//------------------------------------------------------------------------------
+
+/// <summary> A fractional delay FIR whose taps are polynomials of the fractional delay. </summary>
+/// <remarks> Tap i at fractional delay mu is sum_m branch(m)[i] * mu^m, with mu in [0, 1]. The total delay
+///		of the filter is <see cref="delay"/> + mu samples. </remarks>
+template <class T>
+class FarrowFilter {
+	static_assert(std::is_floating_point_v<T>);
+
+public:
+	FarrowFilter() = default;
+	FarrowFilter(size_t size, size_t order) : m_size(size), m_coefficients((order + 1) * size, T(0)) {}
+
+	/// <summary> The number of taps of the filter. </summary>
+	size_t size() const { return m_size; }
+	/// <summary> The order of the polynomials. </summary>
+	size_t order() const { return m_size == 0 ? 0 : m_coefficients.size() / m_size - 1; }
+	/// <summary> The delay of the filter in samples at zero fractional delay. </summary>
+	T delay() const { return T(m_size - 2) / T(2); }
+
+	/// <summary> The coefficients of mu^m for every tap. </summary>
+	BasicSignalView<T, TIME_DOMAIN> branch(size_t m) { return AsView(m_coefficients).subsignal(m * m_size, m_size); }
+	BasicSignalView<const T, TIME_DOMAIN> branch(size_t m) const { return AsConstView(m_coefficients).subsignal(m * m_size, m_size); }
+
+	/// <summary> Evaluates the taps at fractional delay <paramref name="mu"/>. </summary>
+	template <class SignalR, std::enable_if_t<is_mutable_signal_v<SignalR>, int> = 0>
+	void Evaluate(SignalR&& taps, T mu) const;
+
+private:
+	size_t m_size = 0;
+	BasicSignal<T, TIME_DOMAIN> m_coefficients;
+};
+
+
+template <class T>
+template <class SignalR, std::enable_if_t<is_mutable_signal_v<SignalR>, int>>
+void FarrowFilter<T>::Evaluate(SignalR&& taps, T mu) const {
+	assert(taps.size() == size());
+	const auto highest = branch(order());
+	std::copy(highest.begin(), highest.end(), taps.begin());
+	for (size_t m = order(); m-- > 0;) {
+		const auto coefficients = branch(m);
+		for (size_t i = 0; i < taps.size(); ++i) {
+			taps[i] = taps[i] * mu + coefficients[i];
+		}
+	}
+}
+
+
+/// <summary> Designs a Lagrange interpolator of <paramref name="size"/> taps as a Farrow filter. </summary>
+/// <remarks> The polynomials are of order size - 1 and the filter is maximally flat at DC for all delays.
+///		The fractional delay is centered on the middle of the filter to keep the error small. </remarks>
+template <class T>
+FarrowFilter<T> DesignFarrowLagrange(size_t size) {
+	assert(size >= 2);
+	FarrowFilter<T> filter(size, size - 1);
+	const double offset = (double(size) - 2.0) / 2.0;
+
+	// Tap i is prod_{j != i} (mu + offset - j) / (i - j), expanded in powers of mu.
+	std::vector<double> polynomial(size);
+	for (size_t i = 0; i < size; ++i) {
+		std::fill(polynomial.begin(), polynomial.end(), 0.0);
+		polynomial[0] = 1.0;
+		size_t degree = 0;
+		for (size_t j = 0; j < size; ++j) {
+			if (j == i) {
+				continue;
+			}
+			const double scale = 1.0 / (double(i) - double(j));
+			const double constant = offset - double(j);
+			++degree;
+			for (size_t m = degree + 1; m-- > 0;) {
+				const double lower = m > 0 ? polynomial[m - 1] : 0.0;
+				polynomial[m] = (polynomial[m] * constant + lower) * scale;
+			}
+		}
+		for (size_t m = 0; m < size; ++m) {
+			filter.branch(m)[i] = T(polynomial[m]);
+		}
+	}
+	return filter;
+}
+
+
+/// <summary> Fits polynomials to the phases of an oversampled lowpass to get a Farrow filter. </summary>
+/// <param name="prototype"> A symmetric lowpass with unity DC gain at <paramref name="oversampling"/> times
+///		the rate, for example from <see cref="fir::KernelLeastSquares"/>. It has size * oversampling + 1 taps, where size is at least 2. </param>
+/// <param name="order"> The order of the polynomials, must be less than <paramref name="oversampling"/>. </param>
+/// <remarks> The taps are fitted to the prototype in the least squares sense. The frequency response
+///		follows the prototype's for every fractional delay. </remarks>
+template <class T, class SignalU, std::enable_if_t<is_signal_like_v<SignalU>, int> = 0>
+FarrowFilter<T> DesignFarrow(const SignalU& prototype, size_t oversampling, size_t order) {
+	assert(oversampling > order);
+	assert(prototype.size() % oversampling == 1);
+	const size_t size = prototype.size() / oversampling;
+	assert(size >= 2);
+	FarrowFilter<T> filter(size, order);
+
+	// Tap i at fractional delay mu is the prototype at (i + 1 - mu) * oversampling, evaluated at the
+	// fractional delays r / oversampling that the prototype has samples for.
+	Eigen::MatrixXd powers(oversampling + 1, order + 1);
+	for (size_t r = 0; r <= oversampling; ++r) {
+		const double mu = double(r) / double(oversampling);
+		double power = 1.0;
+		for (size_t m = 0; m <= order; ++m) {
+			powers(r, m) = power;
+			power *= mu;
+		}
+	}
+	const Eigen::ColPivHouseholderQR<Eigen::MatrixXd> decomp{ powers };
+	Eigen::VectorXd samples(oversampling + 1);
+	for (size_t i = 0; i < size; ++i) {
+		for (size_t r = 0; r <= oversampling; ++r) {
+			samples(r) = double(prototype[(i + 1) * oversampling - r]) * double(oversampling);
+		}
+		const Eigen::VectorXd polynomial = decomp.solve(samples);
+		for (size_t m = 0; m <= order; ++m) {
+			filter.branch(m)[i] = T(polynomial(m));
+		}
+	}
+	return filter;
+}
+
+
+//------------------------------------------------------------------------------
+// Delay line
+//------------------------------------------------------------------------------
+
+/// <summary> Delays a stream by a fractional number of samples that may change for every sample. </summary>
+/// <remarks> The delay can go from the filter's delay up to <paramref name="maxDelay"/>. The integer part
+///		above the filter's delay is taken from the input history, the rest is done by the Farrow filter. </remarks>
+template <class T, class P = remove_complex_t<T>>
+class FarrowDelay {
+public:
+	FarrowDelay(const FarrowFilter<P>& filter, P maxDelay);
+
+	/// <summary> Delays <paramref name="input"/> by <paramref name="delay"/> samples. </summary>
+	/// <remarks> The output has the same size as the input. </remarks>
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	void process(SignalR&& output, const SignalT& input, P delay);
+	/// <summary> Delays each sample of <paramref name="input"/> by the corresponding sample of <paramref name="delays"/>. </summary>
+	template <class SignalR, class SignalT, class SignalD, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT> && is_signal_like_v<SignalD>, int> = 0>
+	void process(SignalR&& output, const SignalT& input, const SignalD& delays);
+	void reset();
+
+	P min_delay() const { return m_filter.delay(); }
+	P max_delay() const { return m_maxDelay; }
+
+private:
+	std::pair<int64_t, P> split(P delay) const;
+
+	FarrowFilter<P> m_filter;
+	std::vector<BasicSignal<P, TIME_DOMAIN>> m_branches;
+	BasicSignal<P, TIME_DOMAIN> m_taps;
+	P m_maxDelay;
+	size_t m_maxInteger;
+	impl::StreamHistory<T> m_input;
+};
+
+
+template <class T, class P>
+FarrowDelay<T, P>::FarrowDelay(const FarrowFilter<P>& filter, P maxDelay)
+	: m_filter(filter), m_taps(filter.size()), m_maxDelay(maxDelay) {
+	assert(filter.size() > 0);
+	assert(maxDelay >= filter.delay());
+	m_maxInteger = size_t(std::ceil(maxDelay - filter.delay()));
+	m_input = impl::StreamHistory<T>(filter.size() - 1 + m_maxInteger);
+	// The branches are reversed so that they line up with windows of the input.
+	for (size_t m = 0; m <= filter.order(); ++m) {
+		const auto branch = filter.branch(m);
+		m_branches.emplace_back(branch.rbegin(), branch.rend());
+	}
+}
+
+template <class T, class P>
+std::pair<int64_t, P> FarrowDelay<T, P>::split(P delay) const {
+	assert(min_delay() <= delay && delay <= max_delay());
+	const P extra = std::max(P(0), delay - m_filter.delay());
+	const P integer = std::min(std::floor(extra), P(m_maxInteger));
+	return { int64_t(integer), extra - integer };
+}
+
+template <class T, class P>
+template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int>>
+void FarrowDelay<T, P>::process(SignalR&& output, const SignalT& input, P delay) {
+	assert(output.size() == input.size());
+	const int64_t first = m_input.size();
+	m_input.append(input);
+
+	const auto [integer, mu] = split(delay);
+	m_filter.Evaluate(m_taps, mu);
+	std::reverse(m_taps.begin(), m_taps.end());
+	for (size_t n = 0; n < input.size(); ++n) {
+		const auto window = m_input.window(first + int64_t(n) - integer, m_taps.size());
+		output[n] = DotProduct(window, m_taps);
+	}
+	m_input.release(m_input.size() - int64_t(m_taps.size() - 1 + m_maxInteger));
+}
+
+template <class T, class P>
+template <class SignalR, class SignalT, class SignalD, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT> && is_signal_like_v<SignalD>, int>>
+void FarrowDelay<T, P>::process(SignalR&& output, const SignalT& input, const SignalD& delays) {
+	assert(output.size() == input.size());
+	assert(delays.size() == input.size());
+	const int64_t first = m_input.size();
+	m_input.append(input);
+
+	const size_t order = m_filter.order();
+	for (size_t n = 0; n < input.size(); ++n) {
+		const auto [integer, mu] = split(P(delays[n]));
+		const auto window = m_input.window(first + int64_t(n) - integer, m_filter.size());
+		auto sample = DotProduct(window, m_branches[order]);
+		for (size_t m = order; m-- > 0;) {
+			sample = sample * mu + DotProduct(window, m_branches[m]);
+		}
+		output[n] = sample;
+	}
+	m_input.release(m_input.size() - int64_t(m_filter.size() - 1 + m_maxInteger));
+}
+
+template <class T, class P>
+void FarrowDelay<T, P>::reset() {
+	m_input.reset();
+}
+
+} // namespace dspbb
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "../Math/FFT.hpp"
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalTraits.hpp"
+#include "../Primitives/SignalView.hpp"
+#include "../Utility/TypeTraits.hpp"
+#include "Windowing.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <complex>
+
+
+namespace dspbb {
+
+namespace impl {
+
+	// Moves the spectrum of a length N signal into the spectrum of a length M signal. For real signals, only
+	// the non-negative frequencies are stored, otherwise negative frequency -k is at index size - k.
+	template <class T, class WindowFunc>
+	void FftResampleSpectrum(SpectrumView<std::complex<T>> out,
+							 SpectrumView<const std::complex<T>> in,
+							 size_t inputLength,
+							 size_t outputLength,
+							 bool isReal,
+							 WindowFunc windowFunc) {
+		const ptrdiff_t common = ptrdiff_t(std::min(inputLength, outputLength));
+		const ptrdiff_t nyquist = common / 2;
+		const ptrdiff_t shared = (common - 1) / 2;
+		const T scale = T(outputLength) / T(inputLength);
+
+		Signal<T> window(2 * nyquist + 1);
+		windowFunc(window);
+		window *= scale;
+		const auto weight = [&](ptrdiff_t k) { return window[nyquist + k]; };
+		const auto inBin = [&](ptrdiff_t k) { return in[k >= 0 ? k : ptrdiff_t(inputLength) + k]; };
+		const auto outBin = [&](ptrdiff_t k) -> std::complex<T>& { return out[k >= 0 ? k : ptrdiff_t(outputLength) + k]; };
+
+		std::fill(out.begin(), out.end(), std::complex<T>(0));
+		for (ptrdiff_t k = 0; k <= shared; ++k) {
+			outBin(k) = inBin(k) * weight(k);
+		}
+		if (!isReal) {
+			for (ptrdiff_t k = -shared; k < 0; ++k) {
+				outBin(k) = inBin(k) * weight(k);
+			}
+		}
+
+		// When the shorter signal has an even length, its Nyquist bin stands for both +N/2 and -N/2.
+		if (common % 2 == 0 && common > 0) {
+			const ptrdiff_t k = nyquist;
+			if (inputLength == outputLength) {
+				outBin(k) = inBin(k) * weight(k);
+			}
+			else if (inputLength < outputLength) {
+				// The energy is split between the positive and the negative frequency.
+				const auto half = inBin(k) * (weight(k) / T(2));
+				outBin(k) = half;
+				if (!isReal) {
+					outBin(-k) = half;
+				}
+			}
+			else {
+				// Both frequencies fold onto the output's Nyquist bin.
+				outBin(k) = isReal ? (inBin(k) + std::conj(inBin(k))) * weight(k) : (inBin(k) + inBin(-k)) * weight(k);
+			}
+		}
+	}
+
+} // namespace impl
+
+
+/// <summary> Resamples the whole of <paramref name="input"/> to the length of <paramref name="output"/>
+///		by truncating or zero-padding its spectrum. </summary>
+/// <param name="windowFunc"> Applied to the spectrum over the band shared by the input and the output,
+///		centered on DC. </param>
+/// <remarks> The signal is treated as one period of a periodic signal, so the ends should match or be tapered.
+///		The cost is that of an FFT of each length regardless of the ratio. Lengths with only small prime
+///		factors, see <see cref="FftFastLength"/>, are the fastest. </remarks>
+template <class SignalR, class SignalT, class WindowFunc, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+void FftResample(SignalR&& output, const SignalT& input, WindowFunc windowFunc) {
+	using T = std::remove_const_t<typename signal_traits<std::decay_t<SignalT>>::type>;
+	using R = typename signal_traits<std::decay_t<SignalR>>::type;
+	using U = remove_complex_t<T>;
+	static_assert(is_complex_v<R> || !is_complex_v<T>, "Output must be complex if input is complex.");
+	assert(input.size() > 0);
+
+	if (output.size() == 0) {
+		return;
+	}
+	if constexpr (is_complex_v<T>) {
+		Spectrum<std::complex<U>> inSpectrum(input.size());
+		Spectrum<std::complex<U>> outSpectrum(output.size());
+		Fft(inSpectrum, input);
+		impl::FftResampleSpectrum(AsView(outSpectrum), AsConstView(inSpectrum), input.size(), output.size(), false, windowFunc);
+		Ifft(output, outSpectrum);
+	}
+	else {
+		Spectrum<std::complex<U>> inSpectrum(input.size() / 2 + 1);
+		Spectrum<std::complex<U>> outSpectrum(output.size() / 2 + 1);
+		Fft(inSpectrum, input);
+		impl::FftResampleSpectrum(AsView(outSpectrum), AsConstView(inSpectrum), input.size(), output.size(), true, windowFunc);
+		if constexpr (is_complex_v<R>) {
+			Signal<U> real(output.size());
+			Ifft(real, outSpectrum);
+			std::copy(real.begin(), real.end(), output.begin());
+		}
+		else {
+			Ifft(output, outSpectrum);
+		}
+	}
+}
+
+template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+void FftResample(SignalR&& output, const SignalT& input) {
+	FftResample(output, input, windows::rectangular);
+}
+
+template <class SignalT, class WindowFunc, std::enable_if_t<is_signal_like_v<SignalT>, int> = 0>
+auto FftResample(const SignalT& input, size_t newLength, WindowFunc windowFunc) {
+	using T = std::remove_const_t<typename signal_traits<std::decay_t<SignalT>>::type>;
+	constexpr auto Domain = signal_traits<std::decay_t<SignalT>>::domain;
+	BasicSignal<T, Domain> output(newLength);
+	FftResample(output, input, windowFunc);
+	return output;
+}
+
+template <class SignalT, std::enable_if_t<is_signal_like_v<SignalT>, int> = 0>
+auto FftResample(const SignalT& input, size_t newLength) {
+	return FftResample(input, newLength, windows::rectangular);
+}
+
+} // namespace dspbb
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "../LTISystems/Systems.hpp"
+#include "../Math/Convolution.hpp"
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalTraits.hpp"
+#include "../Primitives/SignalView.hpp"
+#include "../Utility/Parallel.hpp"
+#include "../Utility/TypeTraits.hpp"
+#include "IIR/Realizations.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+
+namespace dspbb {
+
+namespace impl {
+
+	namespace filtfilt {
+
+		template <class T, class U>
+		auto MakeRealization(const CascadedBiquad<U>& sys) {
+			return CascadedForm<T>{ sys.order() };
+		}
+
+		template <class T, class U>
+		auto MakeRealization(const DiscreteTransferFunction<U>& sys) {
+			return DirectFormII<T>{ sys.order() };
+		}
+
+		template <class U>
+		size_t PaddingLength(const CascadedBiquad<U>& sys) {
+			return 3 * (2 * sys.sections.size() + 1);
+		}
+
+		template <class U>
+		size_t PaddingLength(const DiscreteTransferFunction<U>& sys) {
+			return 3 * std::max(sys.numerator.size(), sys.denominator.size());
+		}
+
+		// Number of samples after which the impulse response stays below tolerance relative to its peak.
+		// A segment that is warmed up for this many samples from a steady state matches the serial result to the same tolerance.
+		template <class T, class System>
+		size_t DecayLength(const System& sys, T tolerance, size_t maxLength) {
+			auto state = MakeRealization<T>(sys);
+			const size_t window = sys.order() + 1;
+			T peak = T(0);
+			size_t numQuiet = 0;
+			for (size_t n = 0; n < maxLength; ++n) {
+				const T magnitude = std::abs(state.feed(n == 0 ? T(1) : T(0), sys));
+				peak = std::max(peak, magnitude);
+				numQuiet = magnitude <= tolerance * peak ? numQuiet + 1 : 0;
+				if (numQuiet >= window) {
+					return n + 1;
+				}
+			}
+			return maxLength;
+		}
+
+		template <class SignalR, class SignalT, class System, class T>
+		void ForwardPass(SignalR& out, const SignalT& in, const System& sys, size_t numThreads, T tolerance) {
+			using R = typename signal_traits<std::decay_t<SignalR>>::type;
+
+			const size_t warmup = numThreads > 1 ? DecayLength(sys, tolerance, in.size()) : 0;
+			const auto filterRange = [&out, &in, &sys, warmup](size_t first, size_t last) {
+				const size_t warmupFirst = first > warmup ? first - warmup : 0;
+				auto state = MakeRealization<R>(sys);
+				state.reset(in[warmupFirst], sys);
+				for (size_t i = warmupFirst; i < first; ++i) {
+					state.feed(in[i], sys);
+				}
+				state.feed(in.begin() + first, in.begin() + last, out.begin() + first, sys);
+			};
+			ParallelFor(in.size(), numThreads, filterRange);
+		}
+
+		template <class SignalR, class SignalT, class SignalU>
+		void ForwardPassFir(SignalR& out, const SignalT& in, const SignalU& filter, size_t numThreads) {
+			using T = std::remove_const_t<typename signal_traits<std::decay_t<SignalT>>::type>;
+			constexpr auto Domain = signal_traits<std::decay_t<SignalT>>::domain;
+
+			// The steady state of an FIR filter is a history filled with the first sample.
+			const size_t history = filter.size() - 1;
+			BasicSignal<T, Domain> extended(in.size() + history, in[0]);
+			std::copy(in.begin(), in.end(), extended.begin() + history);
+
+			const auto filterRange = [&out, &extended, &filter, history](size_t first, size_t last) {
+				Convolution(AsView(out).subsignal(first, last - first), extended, filter, first + history);
+			};
+			ParallelFor(in.size(), numThreads, filterRange);
+		}
+
+		template <class SignalR, class SignalT>
+		void OddExtension(SignalR& out, const SignalT& signal, size_t padLength) {
+			assert(out.size() == signal.size() + 2 * padLength);
+			assert(padLength < signal.size());
+			const auto first = signal[0];
+			const auto last = signal[signal.size() - 1];
+			for (size_t i = 1; i <= padLength; ++i) {
+				out[padLength - i] = first + first - signal[i];
+				out[padLength + signal.size() - 1 + i] = last + last - signal[signal.size() - 1 - i];
+			}
+			std::copy(signal.begin(), signal.end(), out.begin() + padLength);
+		}
+
+		template <class SignalR, class SignalT, class PassFunc>
+		void FiltFilt(SignalR& out, const SignalT& signal, size_t padLength, PassFunc pass) {
+			using R = typename signal_traits<std::decay_t<SignalR>>::type;
+			constexpr auto Domain = signal_traits<std::decay_t<SignalR>>::domain;
+
+			assert(out.size() == signal.size());
+			if (signal.empty()) {
+				return;
+			}
+
+			padLength = std::min(padLength, signal.size() - 1);
+			BasicSignal<R, Domain> extended(signal.size() + 2 * padLength);
+			BasicSignal<R, Domain> filtered(extended.size());
+			OddExtension(extended, signal, padLength);
+
+			pass(filtered, extended);
+			std::reverse(filtered.begin(), filtered.end());
+			pass(extended, filtered);
+			std::reverse_copy(extended.begin() + padLength, extended.begin() + padLength + signal.size(), out.begin());
+		}
+
+	} // namespace filtfilt
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// IIR
+//------------------------------------------------------------------------------
+
+template <class SignalR, class SignalT, class U, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+void FiltFilt(SignalR&& out, const SignalT& signal, const CascadedBiquad<U>& filter, size_t numThreads = 1, double tolerance = 1e-9) {
+	using R = remove_complex_t<typename signal_traits<std::decay_t<SignalR>>::type>;
+	const auto pass = [&filter, numThreads, tolerance](auto& passOut, const auto& passIn) {
+		impl::filtfilt::ForwardPass(passOut, passIn, filter, numThreads, R(tolerance));
+	};
+	impl::filtfilt::FiltFilt(out, signal, impl::filtfilt::PaddingLength(filter), pass);
+}
+
+template <class SignalR, class SignalT, class U, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+void FiltFilt(SignalR&& out, const SignalT& signal, const DiscreteTransferFunction<U>& filter, size_t numThreads = 1, double tolerance = 1e-9) {
+	using R = remove_complex_t<typename signal_traits<std::decay_t<SignalR>>::type>;
+	const auto pass = [&filter, numThreads, tolerance](auto& passOut, const auto& passIn) {
+		impl::filtfilt::ForwardPass(passOut, passIn, filter, numThreads, R(tolerance));
+	};
+	impl::filtfilt::FiltFilt(out, signal, impl::filtfilt::PaddingLength(filter), pass);
+}
+
+template <class SignalT, class U, std::enable_if_t<is_signal_like_v<std::decay_t<SignalT>>, int> = 0>
+auto FiltFilt(const SignalT& signal, const CascadedBiquad<U>& filter, size_t numThreads = 1, double tolerance = 1e-9) {
+	using T = std::remove_const_t<typename signal_traits<std::decay_t<SignalT>>::type>;
+	constexpr auto Domain = signal_traits<std::decay_t<SignalT>>::domain;
+	BasicSignal<T, Domain> out(signal.size());
+	FiltFilt(out, signal, filter, numThreads, tolerance);
+	return out;
+}
+
+template <class SignalT, class U, std::enable_if_t<is_signal_like_v<std::decay_t<SignalT>>, int> = 0>
+auto FiltFilt(const SignalT& signal, const DiscreteTransferFunction<U>& filter, size_t numThreads = 1, double tolerance = 1e-9) {
+	using T = std::remove_const_t<typename signal_traits<std::decay_t<SignalT>>::type>;
+	constexpr auto Domain = signal_traits<std::decay_t<SignalT>>::domain;
+	BasicSignal<T, Domain> out(signal.size());
+	FiltFilt(out, signal, filter, numThreads, tolerance);
+	return out;
+}
+
+
+//------------------------------------------------------------------------------
+// FIR
+//------------------------------------------------------------------------------
+
+template <class SignalR, class SignalT, class SignalU, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT, SignalU>, int> = 0>
+void FiltFilt(SignalR&& out, const SignalT& signal, const SignalU& filter, size_t numThreads = 1) {
+	assert(!filter.empty());
+	const auto pass = [&filter, numThreads](auto& passOut, const auto& passIn) {
+		impl::filtfilt::ForwardPassFir(passOut, passIn, filter, numThreads);
+	};
+	impl::filtfilt::FiltFilt(out, signal, 3 * filter.size(), pass);
+}
+
+template <class SignalT, class SignalU, std::enable_if_t<is_same_domain_v<SignalT, SignalU>, int> = 0>
+auto FiltFilt(const SignalT& signal, const SignalU& filter, size_t numThreads = 1) {
+	using T = std::remove_const_t<typename signal_traits<std::decay_t<SignalT>>::type>;
+	using U = std::remove_const_t<typename signal_traits<std::decay_t<SignalU>>::type>;
+	using R = multiplies_result_t<T, U>;
+	constexpr auto Domain = signal_traits<std::decay_t<SignalT>>::domain;
+	BasicSignal<R, Domain> out(signal.size());
+	FiltFilt(out, signal, filter, numThreads);
+	return out;
+}
+
+} // namespace dspbb
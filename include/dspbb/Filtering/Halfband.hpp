@@ -0,0 +1,265 @@
+#pragma once
+
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalTraits.hpp"
+#include "../Primitives/SignalView.hpp"
+#include "../Utility/TypeTraits.hpp"
+#include "DecimatingFir.hpp"
+#include "FIR.hpp"
+#include "Resample.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace dspbb {
+
+/// <summary> A symmetric halfband lowpass that stores only its non-zero coefficients. </summary>
+/// <remarks> The filter has 4k+3 taps. Every second tap counting from the centre is zero, so only the
+///		k+1 taps h[0], h[2], ..., h[2k] of the first half and the centre tap are kept. </remarks>
+template <class T>
+class HalfbandFilter {
+public:
+	HalfbandFilter() = default;
+	/// <summary> Takes the non-zero taps of <paramref name="filter"/>, which is assumed to be a halfband filter. </summary>
+	template <class SignalU, std::enable_if_t<is_signal_like_v<SignalU>, int> = 0>
+	explicit HalfbandFilter(const SignalU& filter);
+
+	/// <summary> The number of taps of the full filter, including zeros. </summary>
+	size_t size() const { return 4 * m_taps.size() - 1; }
+	/// <summary> The group delay in samples at the rate of the full filter. </summary>
+	size_t delay() const { return size() / 2; }
+	/// <summary> The taps h[0], h[2], ..., h[2k], the second half mirrors these. </summary>
+	const BasicSignal<T, TIME_DOMAIN>& taps() const { return m_taps; }
+	T center() const { return m_center; }
+
+	/// <summary> Expands the filter into all of its taps. </summary>
+	BasicSignal<T, TIME_DOMAIN> full() const;
+
+private:
+	BasicSignal<T, TIME_DOMAIN> m_taps;
+	T m_center = T(0);
+};
+
+
+template <class T>
+template <class SignalU, std::enable_if_t<is_signal_like_v<SignalU>, int>>
+HalfbandFilter<T>::HalfbandFilter(const SignalU& filter) {
+	assert(filter.size() % 4 == 3);
+	m_taps.resize(filter.size() / 4 + 1);
+	for (size_t i = 0; i < m_taps.size(); ++i) {
+		m_taps[i] = T(filter[2 * i]);
+	}
+	m_center = T(filter[filter.size() / 2]);
+}
+
+template <class T>
+BasicSignal<T, TIME_DOMAIN> HalfbandFilter<T>::full() const {
+	BasicSignal<T, TIME_DOMAIN> filter(size(), T(0));
+	for (size_t i = 0; i < m_taps.size(); ++i) {
+		filter[2 * i] = m_taps[i];
+		filter[size() - 1 - 2 * i] = m_taps[i];
+	}
+	filter[size() / 2] = m_center;
+	return filter;
+}
+
+
+//------------------------------------------------------------------------------
+// Design
+//------------------------------------------------------------------------------
+
+namespace impl {
+	template <class T, class Desc>
+	HalfbandFilter<T> DesignHalfband(size_t size, const Desc& desc) {
+		assert(size % 4 == 3);
+		BasicSignal<T, TIME_DOMAIN> filter(size);
+		DesignFilter(filter, desc);
+		HalfbandFilter<T> halfband{ filter };
+
+		// The taps are renormalized so that the centre tap is exactly one half and the DC gain is one, which
+		// makes the response of the filter and its mirror image add up to exactly one.
+		BasicSignal<T, TIME_DOMAIN> taps = halfband.taps();
+		taps *= T(0.25) / T(Sum(taps));
+		BasicSignal<T, TIME_DOMAIN> normalized(size, T(0));
+		for (size_t i = 0; i < taps.size(); ++i) {
+			normalized[2 * i] = taps[i];
+			normalized[size - 1 - 2 * i] = taps[i];
+		}
+		normalized[size / 2] = T(0.5);
+		return HalfbandFilter<T>{ normalized };
+	}
+} // namespace impl
+
+
+/// <summary> Designs a halfband lowpass with the window method. </summary>
+/// <param name="size"> Number of taps of the full filter, must be of the form 4k+3. </param>
+/// <remarks> The cutoff of <paramref name="desc"/> is ignored, only its window is used. </remarks>
+template <class T, class ParamType, class WindowType>
+HalfbandFilter<T> DesignHalfband(size_t size, const impl::windowed::LowpassDesc<ParamType, WindowType>& desc) {
+	return impl::DesignHalfband<T>(size, Fir.Lowpass.Windowed.Cutoff(ParamType(0.5)).Window(desc.window));
+}
+
+/// <summary> Designs a halfband lowpass with the least-squares method. </summary>
+/// <param name="size"> Number of taps of the full filter, must be of the form 4k+3. </param>
+/// <remarks> The transition band of <paramref name="desc"/> is moved to be centred on half the Nyquist frequency,
+///		and the passband and stopband get the same weight, as the filter has to be symmetric. </remarks>
+template <class T, class ParamType>
+HalfbandFilter<T> DesignHalfband(size_t size, const impl::least_squares::LowpassDesc<ParamType>& desc) {
+	const ParamType halfWidth = (desc.cutoffEnd - desc.cutoffBegin) / ParamType(2);
+	const auto symmetric = desc.Cutoff(ParamType(0.5) - halfWidth, ParamType(0.5) + halfWidth).Weight(ParamType(1), desc.weightTransition, ParamType(1));
+	return impl::DesignHalfband<T>(size, symmetric);
+}
+
+
+//------------------------------------------------------------------------------
+// Decimation
+//------------------------------------------------------------------------------
+
+namespace impl {
+	template <class SignalT, class P>
+	auto HalfbandDecimateSample(const SignalT& input, const HalfbandFilter<P>& halfband, ptrdiff_t newest) {
+		using T = typename signal_traits<std::decay_t<SignalT>>::type;
+		using R = multiplies_result_t<T, P>;
+		const auto at = [&input](ptrdiff_t index) {
+			return 0 <= index && index < ptrdiff_t(input.size()) ? input[index] : T(0);
+		};
+		const ptrdiff_t oldest = newest - ptrdiff_t(halfband.size()) + 1;
+		R sum = R(halfband.center()) * at(newest - ptrdiff_t(halfband.delay()));
+		for (size_t i = 0; i < halfband.taps().size(); ++i) {
+			sum += R(halfband.taps()[i]) * (at(newest - 2 * ptrdiff_t(i)) + at(oldest + 2 * ptrdiff_t(i)));
+		}
+		return sum;
+	}
+} // namespace impl
+
+
+/// <summary> Filters with a halfband lowpass and keeps every second sample, starting with the first. </summary>
+/// <remarks> Produces the same samples as <see cref="DecimatingFir"/> with the full filter and a rate of 2.
+///		The zero taps are skipped, the symmetric taps are folded to share a multiplication, and the centre tap
+///		scales a single delayed input sample, so an output takes k+2 multiplications instead of 4k+3. </remarks>
+template <class SignalR, class SignalT, class P, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+void HalfbandDecimate(SignalR&& output, const SignalT& input, const HalfbandFilter<P>& halfband) {
+	assert(output.size() <= DecimatingFirLength(input.size(), halfband.size(), 2));
+
+	const size_t numTaps = halfband.taps().size();
+	const size_t delay = halfband.delay();
+	const size_t span = halfband.size() - 1;
+	const auto* taps = halfband.taps().data();
+	const P center = halfband.center();
+
+	// Output i reads the input from 2i - span to 2i, which is fully inside the input on the interior.
+	const size_t interiorFirst = std::min(output.size(), (span + 1) / 2);
+	const size_t interiorLast = std::max(interiorFirst, std::min(output.size(), (input.size() + 1) / 2));
+
+	for (size_t i = 0; i < interiorFirst; ++i) {
+		output[i] = impl::HalfbandDecimateSample(input, halfband, 2 * ptrdiff_t(i));
+	}
+	for (size_t i = interiorFirst; i < interiorLast; ++i) {
+		const auto* newest = input.data() + 2 * i;
+		const auto* oldest = newest - span;
+		auto sum = center * newest[-ptrdiff_t(delay)];
+		for (size_t j = 0; j < numTaps; ++j) {
+			sum += taps[j] * (newest[-2 * ptrdiff_t(j)] + oldest[2 * j]);
+		}
+		output[i] = sum;
+	}
+	for (size_t i = interiorLast; i < output.size(); ++i) {
+		output[i] = impl::HalfbandDecimateSample(input, halfband, 2 * ptrdiff_t(i));
+	}
+}
+
+template <class SignalT, class P, std::enable_if_t<is_signal_like_v<SignalT>, int> = 0>
+auto HalfbandDecimate(const SignalT& input, const HalfbandFilter<P>& halfband) {
+	using T = typename signal_traits<std::decay_t<SignalT>>::type;
+	using R = multiplies_result_t<T, P>;
+	constexpr auto Domain = signal_traits<std::decay_t<SignalT>>::domain;
+
+	BasicSignal<R, Domain> output(DecimatingFirLength(input.size(), halfband.size(), 2));
+	HalfbandDecimate(output, input, halfband);
+	return output;
+}
+
+
+//------------------------------------------------------------------------------
+// Interpolation
+//------------------------------------------------------------------------------
+
+namespace impl {
+	template <class SignalT, class P>
+	auto HalfbandInterpolateSample(const SignalT& lrInput, const HalfbandFilter<P>& halfband, ptrdiff_t hrIndex) {
+		using T = typename signal_traits<std::decay_t<SignalT>>::type;
+		using R = multiplies_result_t<T, P>;
+		const auto at = [&lrInput](ptrdiff_t index) {
+			return 0 <= index && index < ptrdiff_t(lrInput.size()) ? lrInput[index] : T(0);
+		};
+		if (hrIndex % 2 == 1) {
+			return R(P(2) * halfband.center()) * at((hrIndex - ptrdiff_t(halfband.delay())) / 2);
+		}
+		const ptrdiff_t newest = hrIndex / 2;
+		const ptrdiff_t oldest = newest - ptrdiff_t(halfband.taps().size()) * 2 + 1;
+		R sum = R(0);
+		for (size_t i = 0; i < halfband.taps().size(); ++i) {
+			sum += R(P(2) * halfband.taps()[i]) * (at(newest - ptrdiff_t(i)) + at(oldest + ptrdiff_t(i)));
+		}
+		return sum;
+	}
+} // namespace impl
+
+
+/// <summary> Doubles the sample rate using a halfband lowpass as the interpolation filter. </summary>
+/// <param name="hrOffset"> Index of the first high-rate output sample to compute. </param>
+/// <remarks> Produces the same samples as <see cref="Interpolate"/> with the polyphase decomposition of the full
+///		filter into 2 phases. The even phase uses the folded non-zero taps, the odd phase only has the centre
+///		tap, so the odd outputs are scaled copies of delayed input samples. </remarks>
+template <class SignalR, class SignalT, class P, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+void HalfbandInterpolate(SignalR&& hrOutput, const SignalT& lrInput, const HalfbandFilter<P>& halfband, size_t hrOffset) {
+	assert(hrOffset + hrOutput.size() <= InterpolLength(lrInput.size(), halfband.size(), 2, CONV_FULL));
+
+	const size_t numTaps = halfband.taps().size();
+	const size_t lrSpan = 2 * numTaps - 1;
+	const size_t lrDelay = halfband.delay() / 2;
+	const P center = P(2) * halfband.center();
+	BasicSignal<P, TIME_DOMAIN> taps = halfband.taps();
+	taps *= P(2);
+
+	// High-rate output i reads the low-rate input from i / 2 - lrSpan to i / 2.
+	const size_t hrLast = hrOffset + hrOutput.size();
+	const size_t interiorFirst = std::min(hrLast, std::max(hrOffset, 2 * lrSpan));
+	const size_t interiorLast = std::max(interiorFirst, std::min(hrLast, 2 * lrInput.size()));
+
+	auto outputIt = hrOutput.begin();
+	for (size_t i = hrOffset; i < interiorFirst; ++i, ++outputIt) {
+		*outputIt = impl::HalfbandInterpolateSample(lrInput, halfband, ptrdiff_t(i));
+	}
+	for (size_t i = interiorFirst; i < interiorLast; ++i, ++outputIt) {
+		const auto* newest = lrInput.data() + i / 2;
+		if (i % 2 == 1) {
+			*outputIt = center * newest[-ptrdiff_t(lrDelay)];
+		}
+		else {
+			const auto* oldest = newest - lrSpan;
+			auto sum = taps[0] * (newest[0] + oldest[0]);
+			for (size_t j = 1; j < numTaps; ++j) {
+				sum += taps[j] * (newest[-ptrdiff_t(j)] + oldest[j]);
+			}
+			*outputIt = sum;
+		}
+	}
+	for (size_t i = interiorLast; i < hrLast; ++i, ++outputIt) {
+		*outputIt = impl::HalfbandInterpolateSample(lrInput, halfband, ptrdiff_t(i));
+	}
+}
+
+template <class SignalT, class P, std::enable_if_t<is_signal_like_v<SignalT>, int> = 0>
+auto HalfbandInterpolate(const SignalT& lrInput, const HalfbandFilter<P>& halfband, size_t hrOffset, size_t hrLength) {
+	using T = typename signal_traits<std::decay_t<SignalT>>::type;
+	using R = multiplies_result_t<T, P>;
+	constexpr auto Domain = signal_traits<std::decay_t<SignalT>>::domain;
+
+	BasicSignal<R, Domain> output(hrLength, R(0));
+	HalfbandInterpolate(output, lrInput, halfband, hrOffset);
+	return output;
+}
+
+} // namespace dspbb
@@ -9,7 +9,9 @@
 #include "IIR/Descs.hpp"
 #include "IIR/Elliptic.hpp"
 #include "IIR/Filter.hpp"
+#include "IIR/FixedCascade.hpp"
 #include "IIR/Realizations.hpp"
+#include "IIR/StateVariable.hpp"
 
 
 namespace dspbb {
@@ -1,52 +1,78 @@
 #pragma once
 
 #include "../../LTISystems/Systems.hpp"
+#include "../../Utility/Denormals.hpp"
+#include "../../Utility/TypeTraits.hpp"
 #include "Realizations.hpp"
 
+#include <algorithm>
+#include <array>
+
 
 namespace dspbb {
 
 namespace impl {
 	template <class SignalR, class SignalT, class System, class State, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
-	auto Filter(SignalR&& out, const SignalT& signal, const System& filter, State& state) {
+	auto FilterOffset(SignalR&& out, const SignalT& signal, const System& filter, State& state) {
+		using T = std::remove_const_t<typename signal_traits<std::decay_t<SignalT>>::type>;
+		constexpr size_t chunkSize = 256;
+		const auto offset = DenormalOffset<remove_complex_t<T>>();
+		std::array<T, chunkSize> chunk;
+		for (size_t first = 0; first < signal.size(); first += chunkSize) {
+			const size_t count = std::min(chunkSize, signal.size() - first);
+			std::transform(signal.begin() + first, signal.begin() + first + count, chunk.begin(), [offset](const T& value) { return value + offset; });
+			state.feed(chunk.begin(), chunk.begin() + count, out.begin() + first, filter);
+		}
+	}
+
+	template <class SignalR, class SignalT, class System, class State, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	auto Filter(SignalR&& out, const SignalT& signal, const System& filter, State& state, eDenormalHandling denormals) {
 		assert(out.size() == signal.size());
-		state.feed(signal.begin(), signal.end(), out.begin(), filter);
+		switch (denormals) {
+			case eDenormalHandling::FLUSH_TO_ZERO: {
+				ScopedFlushDenormals guard;
+				state.feed(signal.begin(), signal.end(), out.begin(), filter);
+				break;
+			}
+			case eDenormalHandling::DC_OFFSET: FilterOffset(out, signal, filter, state); break;
+			case eDenormalHandling::KEEP: state.feed(signal.begin(), signal.end(), out.begin(), filter); break;
+		}
 	}
 } // namespace impl
 
 template <class SignalR, class SignalT, class T, class U, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
-auto Filter(SignalR&& out, const SignalT& signal, const DiscreteTransferFunction<U>& filter, DirectFormI<T>& state) {
-	impl::Filter(out, signal, filter, state);
+auto Filter(SignalR&& out, const SignalT& signal, const DiscreteTransferFunction<U>& filter, DirectFormI<T>& state, eDenormalHandling denormals = eDenormalHandling::FLUSH_TO_ZERO) {
+	impl::Filter(out, signal, filter, state, denormals);
 }
 
 template <class SignalR, class SignalT, class T, class U, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
-auto Filter(SignalR&& out, const SignalT& signal, const DiscreteTransferFunction<U>& filter, DirectFormII<T>& state) {
-	impl::Filter(out, signal, filter, state);
+auto Filter(SignalR&& out, const SignalT& signal, const DiscreteTransferFunction<U>& filter, DirectFormII<T>& state, eDenormalHandling denormals = eDenormalHandling::FLUSH_TO_ZERO) {
+	impl::Filter(out, signal, filter, state, denormals);
 }
 
 template <class SignalR, class SignalT, class T, class U, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
-auto Filter(SignalR&& out, const SignalT& signal, const CascadedBiquad<U>& filter, CascadedForm<T>& state) {
-	impl::Filter(out, signal, filter, state);
+auto Filter(SignalR&& out, const SignalT& signal, const CascadedBiquad<U>& filter, CascadedForm<T>& state, eDenormalHandling denormals = eDenormalHandling::FLUSH_TO_ZERO) {
+	impl::Filter(out, signal, filter, state, denormals);
 }
 
 template <class SignalT, class T, class U>
-auto Filter(const SignalT& signal, const DiscreteTransferFunction<U>& filter, DirectFormI<T>& state) {
+auto Filter(const SignalT& signal, const DiscreteTransferFunction<U>& filter, DirectFormI<T>& state, eDenormalHandling denormals = eDenormalHandling::FLUSH_TO_ZERO) {
 	SignalT out(signal.size());
-	Filter(out, signal, filter, state);
+	Filter(out, signal, filter, state, denormals);
 	return out;
 }
 
 template <class SignalT, class T, class U>
-auto Filter(const SignalT& signal, const DiscreteTransferFunction<U>& filter, DirectFormII<T>& state) {
+auto Filter(const SignalT& signal, const DiscreteTransferFunction<U>& filter, DirectFormII<T>& state, eDenormalHandling denormals = eDenormalHandling::FLUSH_TO_ZERO) {
 	SignalT out(signal.size());
-	Filter(out, signal, filter, state);
+	Filter(out, signal, filter, state, denormals);
 	return out;
 }
 
 template <class SignalT, class T, class U>
-auto Filter(const SignalT& signal, const CascadedBiquad<U>& filter, CascadedForm<T>& state) {
+auto Filter(const SignalT& signal, const CascadedBiquad<U>& filter, CascadedForm<T>& state, eDenormalHandling denormals = eDenormalHandling::FLUSH_TO_ZERO) {
 	SignalT out(signal.size());
-	Filter(out, signal, filter, state);
+	Filter(out, signal, filter, state, denormals);
 	return out;
 }
 
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "../../LTISystems/Systems.hpp"
+
+#include <array>
+#include <cassert>
+#include <utility>
+
+
+namespace dspbb {
+
+/// <summary> Coefficients of a single biquad section, in the same layout as <see cref="CascadedBiquad::Biquad"/>. </summary>
+/// <remarks> The section's transfer function is (n0 + n1 z + n2 z^2) / (d0 + d1 z + z^2). </remarks>
+template <class T>
+struct FixedBiquad {
+	std::array<T, 3> numerator = { 0, 0, 1 };
+	std::array<T, 2> denominator = { 0, 0 };
+};
+
+
+/// <summary> Cascade of biquads with the number of sections fixed at compile time. </summary>
+/// <remarks> Sections are realized in transposed direct form II. The cascade is a literal type, so both the coefficients
+///		and whole filters can be constexpr, and the per-sample loops are fully unrolled. </remarks>
+template <class T, size_t NumSections>
+class FixedCascade {
+	static_assert(NumSections > 0);
+
+public:
+	constexpr FixedCascade() = default;
+	constexpr explicit FixedCascade(const std::array<FixedBiquad<T>, NumSections>& sections) : m_sections(sections) {}
+	template <class U>
+	explicit FixedCascade(const CascadedBiquad<U>& sys);
+
+	constexpr void reset();
+	static constexpr size_t order() { return 2 * NumSections; }
+	constexpr const std::array<FixedBiquad<T>, NumSections>& sections() const { return m_sections; }
+
+	constexpr T feed(const T& input);
+	template <class InIter, class OutIter>
+	constexpr void feed(InIter first, InIter last, OutIter outFirst);
+
+private:
+	template <size_t... Indices>
+	constexpr T FeedSections(T value, std::index_sequence<Indices...>);
+	template <size_t Index>
+	constexpr T FeedSection(T input);
+
+	std::array<FixedBiquad<T>, NumSections> m_sections = {};
+	std::array<std::array<T, 2>, NumSections> m_state = {};
+};
+
+
+template <class T, size_t NumSections>
+template <class U>
+FixedCascade<T, NumSections>::FixedCascade(const CascadedBiquad<U>& sys) {
+	assert(sys.sections.size() <= NumSections);
+	for (size_t i = 0; i < sys.sections.size(); ++i) {
+		const auto& section = sys.sections[i];
+		m_sections[i].numerator = { T(section.numerator[0]), T(section.numerator[1]), T(section.numerator[2]) };
+		m_sections[i].denominator = { T(section.denominator[0]), T(section.denominator[1]) };
+	}
+}
+
+template <class T, size_t NumSections>
+constexpr void FixedCascade<T, NumSections>::reset() {
+	m_state = {};
+}
+
+template <class T, size_t NumSections>
+constexpr T FixedCascade<T, NumSections>::feed(const T& input) {
+	return FeedSections(input, std::make_index_sequence<NumSections>{});
+}
+
+template <class T, size_t NumSections>
+template <class InIter, class OutIter>
+constexpr void FixedCascade<T, NumSections>::feed(InIter first, InIter last, OutIter outFirst) {
+	for (; first != last; ++first, ++outFirst) {
+		*outFirst = feed(*first);
+	}
+}
+
+template <class T, size_t NumSections>
+template <size_t... Indices>
+constexpr T FixedCascade<T, NumSections>::FeedSections(T value, std::index_sequence<Indices...>) {
+	((value = FeedSection<Indices>(value)), ...);
+	return value;
+}
+
+template <class T, size_t NumSections>
+template <size_t Index>
+constexpr T FixedCascade<T, NumSections>::FeedSection(T input) {
+	const auto& num = std::get<Index>(m_sections).numerator;
+	const auto& den = std::get<Index>(m_sections).denominator;
+	auto& state = std::get<Index>(m_state);
+
+	const T output = num[2] * input + state[0];
+	state[0] = num[1] * input - den[1] * output + state[1];
+	state[1] = num[0] * input - den[0] * output;
+	return output;
+}
+
+} // namespace dspbb
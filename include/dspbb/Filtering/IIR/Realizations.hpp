@@ -5,6 +5,7 @@
 #include "../../Primitives/Signal.hpp"
 
 #include <algorithm>
+#include <numeric>
 
 
 namespace dspbb {
@@ -21,6 +22,8 @@ public:
 
 	void order(size_t order);
 	void reset();
+	template <class InputT, class SystemT, std::enable_if_t<std::is_convertible_v<InputT, T> && std::is_convertible_v<SystemT, T>, int> = 0>
+	void reset(const InputT& input, const DiscreteTransferFunction<SystemT>& sys);
 	size_t order() const;
 
 	template <class InputT, class SystemT, std::enable_if_t<std::is_convertible_v<InputT, T> && std::is_convertible_v<SystemT, T>, int> = 0>
@@ -51,6 +54,17 @@ void DirectFormI<T>::reset() {
 	std::fill(forwardState.begin(), forwardState.end(), T(0));
 }
 
+template <class T>
+template <class InputT, class SystemT, std::enable_if_t<std::is_convertible_v<InputT, T> && std::is_convertible_v<SystemT, T>, int>>
+void DirectFormI<T>::reset(const InputT& input, const DiscreteTransferFunction<SystemT>& sys) {
+	// Steady state of a constant input: all delayed inputs equal the input, all delayed outputs equal the DC response.
+	const auto num = sys.numerator.coefficients();
+	const auto den = sys.denominator.coefficients();
+	const auto dcGain = std::accumulate(num.begin(), num.end(), SystemT(0)) / std::accumulate(den.begin(), den.end(), SystemT(0));
+	std::fill(forwardState.begin(), forwardState.end(), static_cast<T>(input));
+	std::fill(recursiveState.begin(), recursiveState.end(), static_cast<T>(static_cast<T>(input) * static_cast<T>(dcGain)));
+}
+
 template <class T>
 size_t DirectFormI<T>::order() const {
 	return recursiveState.size();
@@ -110,6 +124,8 @@ public:
 
 	void order(size_t order);
 	void reset();
+	template <class InputT, class SystemT, std::enable_if_t<std::is_convertible_v<InputT, T> && std::is_convertible_v<SystemT, T>, int> = 0>
+	void reset(const InputT& input, const DiscreteTransferFunction<SystemT>& sys);
 	size_t order() const;
 
 	template <class InputT, class SystemT, std::enable_if_t<std::is_convertible_v<InputT, T> && std::is_convertible_v<SystemT, T>, int> = 0>
@@ -137,6 +153,17 @@ void DirectFormII<T>::reset() {
 	std::fill(m_state.begin(), m_state.end(), T(0));
 }
 
+template <class T>
+template <class InputT, class SystemT, std::enable_if_t<std::is_convertible_v<InputT, T> && std::is_convertible_v<SystemT, T>, int>>
+void DirectFormII<T>::reset(const InputT& input, const DiscreteTransferFunction<SystemT>& sys) {
+	// Steady state of a constant input: the fixed point of the recursion in feed.
+	const auto den = sys.denominator.coefficients();
+	const auto normalization = T(1) / static_cast<T>(*den.rbegin());
+	const auto recSum = std::accumulate(den.begin(), den.end() - 1, SystemT(0));
+	const auto stateValue = static_cast<T>(input) * normalization / static_cast<T>(SystemT(1) + recSum);
+	std::fill(m_state.begin(), m_state.end(), static_cast<T>(stateValue));
+}
+
 template <class T>
 size_t DirectFormII<T>::order() const {
 	return !m_state.empty() ? m_state.size() - 1 : 0;
@@ -187,6 +214,8 @@ public:
 
 	void order(size_t order);
 	void reset();
+	template <class InputT, class SystemT, std::enable_if_t<std::is_convertible_v<InputT, T> && std::is_convertible_v<SystemT, T>, int> = 0>
+	void reset(const InputT& input, const CascadedBiquad<SystemT>& sys);
 	size_t order() const;
 
 	template <class InputT, class SystemT, std::enable_if_t<std::is_convertible_v<InputT, T> && std::is_convertible_v<SystemT, T>, int> = 0>
@@ -220,6 +249,25 @@ void CascadedForm<T>::reset() {
 	}
 }
 
+template <class T>
+template <class InputT, class SystemT, std::enable_if_t<std::is_convertible_v<InputT, T> && std::is_convertible_v<SystemT, T>, int>>
+void CascadedForm<T>::reset(const InputT& input, const CascadedBiquad<SystemT>& sys) {
+	assert(sys.sections.size() + 1 <= m_sections.size());
+
+	// Steady state of a constant input: every section sees the input scaled by the DC gain of the preceding sections.
+	auto value = static_cast<T>(input);
+	for (size_t i = 0; i < m_sections.size(); ++i) {
+		m_sections[i] = { value, value, value };
+		if (i < sys.sections.size()) {
+			const auto& sysSectionNum = sys.sections[i].numerator;
+			const auto& sysSectionDen = sys.sections[i].denominator;
+			const auto dcGain = (sysSectionNum[0] + sysSectionNum[1] + sysSectionNum[2])
+								/ (sysSectionDen[0] + sysSectionDen[1] + SystemT(1));
+			value = static_cast<T>(value * static_cast<T>(dcGain));
+		}
+	}
+}
+
 template <class T>
 size_t CascadedForm<T>::order() const {
 	return (std::max(size_t(1), m_sections.size()) - 1) * 2;
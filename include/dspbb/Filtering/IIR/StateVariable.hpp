@@ -0,0 +1,263 @@
+#pragma once
+
+#include "../../Kernels/Numeric.hpp"
+#include "../../Utility/Numbers.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+
+namespace dspbb {
+
+/// <summary> Parameters of a trapezoidal-integrator state variable filter. </summary>
+/// <remarks> g is the prewarped integrator gain, k is the damping (1/Q), and the output is
+///		m0*input + m1*bandpass + m2*lowpass. The filter is stable for any g, k > 0, which remains true
+///		when the parameters are interpolated, so they can be modulated freely. </remarks>
+template <class T>
+struct StateVariableCoefficients {
+	T g = T(0);
+	T k = T(2);
+	T m0 = T(0);
+	T m1 = T(0);
+	T m2 = T(1);
+};
+
+
+//------------------------------------------------------------------------------
+// Design
+//------------------------------------------------------------------------------
+
+namespace impl {
+	template <class T>
+	T StateVariableGain(T cutoff) {
+		assert(T(0) < cutoff && cutoff < T(1));
+		return std::tan(pi_v<T> * cutoff / T(2));
+	}
+} // namespace impl
+
+/// <summary> Second order low-pass filter. </summary>
+/// <param name="cutoff"> Normalized cutoff frequency, 1 is Nyquist. </param>
+/// <param name="q"> Quality factor, 1/sqrt(2) for Butterworth response. </param>
+template <class T>
+StateVariableCoefficients<T> StateVariableLowpass(T cutoff, T q) {
+	return { impl::StateVariableGain(cutoff), T(1) / q, T(0), T(0), T(1) };
+}
+
+template <class T>
+StateVariableCoefficients<T> StateVariableHighpass(T cutoff, T q) {
+	const T k = T(1) / q;
+	return { impl::StateVariableGain(cutoff), k, T(1), -k, T(-1) };
+}
+
+template <class T>
+StateVariableCoefficients<T> StateVariableBandpass(T cutoff, T q) {
+	return { impl::StateVariableGain(cutoff), T(1) / q, T(0), T(1), T(0) };
+}
+
+template <class T>
+StateVariableCoefficients<T> StateVariableNotch(T cutoff, T q) {
+	const T k = T(1) / q;
+	return { impl::StateVariableGain(cutoff), k, T(1), -k, T(0) };
+}
+
+template <class T>
+StateVariableCoefficients<T> StateVariableAllpass(T cutoff, T q) {
+	const T k = T(1) / q;
+	return { impl::StateVariableGain(cutoff), k, T(1), T(-2) * k, T(0) };
+}
+
+/// <summary> Peaking equalizer. </summary>
+/// <param name="gain"> Linear amplitude gain at the center frequency. </param>
+template <class T>
+StateVariableCoefficients<T> StateVariableBell(T cutoff, T q, T gain) {
+	const T a = std::sqrt(gain);
+	const T k = T(1) / (q * a);
+	return { impl::StateVariableGain(cutoff), k, T(1), k * (gain - T(1)), T(0) };
+}
+
+/// <param name="gain"> Linear amplitude gain of the shelf. </param>
+template <class T>
+StateVariableCoefficients<T> StateVariableLowShelf(T cutoff, T q, T gain) {
+	const T a = std::sqrt(gain);
+	const T k = T(1) / q;
+	return { impl::StateVariableGain(cutoff) / std::sqrt(a), k, T(1), k * (a - T(1)), gain - T(1) };
+}
+
+/// <param name="gain"> Linear amplitude gain of the shelf. </param>
+template <class T>
+StateVariableCoefficients<T> StateVariableHighShelf(T cutoff, T q, T gain) {
+	const T a = std::sqrt(gain);
+	const T k = T(1) / q;
+	return { impl::StateVariableGain(cutoff) * std::sqrt(a), k, gain, k * (T(1) - a) * a, T(1) - gain };
+}
+
+
+//------------------------------------------------------------------------------
+// Realization
+//------------------------------------------------------------------------------
+
+/// <summary> Second order state variable filter whose coefficients can glide to new targets without zipper noise. </summary>
+template <class T>
+class StateVariableFilter {
+public:
+	StateVariableFilter() = default;
+	explicit StateVariableFilter(const StateVariableCoefficients<T>& coefficients);
+
+	void reset();
+	/// <summary> Changes the coefficients immediately. </summary>
+	void set(const StateVariableCoefficients<T>& coefficients);
+	/// <summary> Linearly interpolates the coefficients to the target over the next <paramref name="rampLength"/> samples. </summary>
+	void target(const StateVariableCoefficients<T>& coefficients, size_t rampLength);
+	const StateVariableCoefficients<T>& coefficients() const;
+
+	template <class InputT>
+	T feed(const InputT& input);
+
+	template <class InIter, class OutIter>
+	void feed(InIter first, InIter last, OutIter outFirst);
+
+private:
+	static constexpr size_t blockSize = 64;
+	struct RampBlock {
+		std::array<T, blockSize> a1;
+		std::array<T, blockSize> a2;
+		std::array<T, blockSize> a3;
+		std::array<T, blockSize> m0;
+		std::array<T, blockSize> m1;
+		std::array<T, blockSize> m2;
+	};
+
+	void update();
+	void ramp(RampBlock& block, size_t count);
+	T tick(T v0, T a1, T a2, T a3, T m0, T m1, T m2);
+
+	StateVariableCoefficients<T> m_current;
+	StateVariableCoefficients<T> m_target;
+	StateVariableCoefficients<T> m_step;
+	size_t m_rampRemaining = 0;
+	T m_a1 = T(1);
+	T m_a2 = T(0);
+	T m_a3 = T(0);
+	T m_ic1eq = T(0);
+	T m_ic2eq = T(0);
+};
+
+
+template <class T>
+StateVariableFilter<T>::StateVariableFilter(const StateVariableCoefficients<T>& coefficients) {
+	set(coefficients);
+}
+
+template <class T>
+void StateVariableFilter<T>::reset() {
+	m_ic1eq = T(0);
+	m_ic2eq = T(0);
+}
+
+template <class T>
+void StateVariableFilter<T>::set(const StateVariableCoefficients<T>& coefficients) {
+	m_current = coefficients;
+	m_rampRemaining = 0;
+	update();
+}
+
+template <class T>
+void StateVariableFilter<T>::target(const StateVariableCoefficients<T>& coefficients, size_t rampLength) {
+	if (rampLength == 0) {
+		set(coefficients);
+		return;
+	}
+	m_target = coefficients;
+	const T scale = T(1) / T(rampLength);
+	m_step.g = (coefficients.g - m_current.g) * scale;
+	m_step.k = (coefficients.k - m_current.k) * scale;
+	m_step.m0 = (coefficients.m0 - m_current.m0) * scale;
+	m_step.m1 = (coefficients.m1 - m_current.m1) * scale;
+	m_step.m2 = (coefficients.m2 - m_current.m2) * scale;
+	m_rampRemaining = rampLength;
+}
+
+template <class T>
+const StateVariableCoefficients<T>& StateVariableFilter<T>::coefficients() const {
+	return m_current;
+}
+
+template <class T>
+template <class InputT>
+T StateVariableFilter<T>::feed(const InputT& input) {
+	T output;
+	feed(&input, &input + 1, &output);
+	return output;
+}
+
+template <class T>
+template <class InIter, class OutIter>
+void StateVariableFilter<T>::feed(InIter first, InIter last, OutIter outFirst) {
+	while (first != last && m_rampRemaining > 0) {
+		const size_t count = std::min({ blockSize, m_rampRemaining, size_t(std::distance(first, last)) });
+		RampBlock block;
+		ramp(block, count);
+		for (size_t i = 0; i < count; ++i, ++first, ++outFirst) {
+			*outFirst = tick(T(*first), block.a1[i], block.a2[i], block.a3[i], block.m0[i], block.m1[i], block.m2[i]);
+		}
+	}
+	for (; first != last; ++first, ++outFirst) {
+		*outFirst = tick(T(*first), m_a1, m_a2, m_a3, m_current.m0, m_current.m1, m_current.m2);
+	}
+}
+
+template <class T>
+void StateVariableFilter<T>::update() {
+	const T& g = m_current.g;
+	m_a1 = T(1) / (T(1) + g * (g + m_current.k));
+	m_a2 = g * m_a1;
+	m_a3 = g * m_a2;
+}
+
+template <class T>
+void StateVariableFilter<T>::ramp(RampBlock& block, size_t count) {
+	assert(count <= m_rampRemaining && count <= blockSize);
+	std::array<T, blockSize> index;
+	std::array<T, blockSize> g;
+	std::array<T, blockSize> k;
+	std::iota(index.begin(), index.begin() + count, T(1));
+
+	const auto linear = [](const T& start, const T& step) {
+		return [start, step](const auto& i) { return start + i * step; };
+	};
+	kernels::Transform(index.begin(), index.begin() + count, g.begin(), linear(m_current.g, m_step.g));
+	kernels::Transform(index.begin(), index.begin() + count, k.begin(), linear(m_current.k, m_step.k));
+	kernels::Transform(index.begin(), index.begin() + count, block.m0.begin(), linear(m_current.m0, m_step.m0));
+	kernels::Transform(index.begin(), index.begin() + count, block.m1.begin(), linear(m_current.m1, m_step.m1));
+	kernels::Transform(index.begin(), index.begin() + count, block.m2.begin(), linear(m_current.m2, m_step.m2));
+	kernels::Transform(g.begin(), g.begin() + count, k.begin(), block.a1.begin(), [](const auto& g, const auto& k) {
+		using V = std::decay_t<decltype(g)>;
+		return V(T(1)) / (V(T(1)) + g * (g + k));
+	});
+	kernels::Transform(g.begin(), g.begin() + count, block.a1.begin(), block.a2.begin(), [](const auto& g, const auto& a1) { return g * a1; });
+	kernels::Transform(g.begin(), g.begin() + count, block.a2.begin(), block.a3.begin(), [](const auto& g, const auto& a2) { return g * a2; });
+
+	m_rampRemaining -= count;
+	if (m_rampRemaining == 0) {
+		m_current = m_target;
+	}
+	else {
+		m_current = { g[count - 1], k[count - 1], block.m0[count - 1], block.m1[count - 1], block.m2[count - 1] };
+	}
+	update();
+}
+
+template <class T>
+T StateVariableFilter<T>::tick(T v0, T a1, T a2, T a3, T m0, T m1, T m2) {
+	const T v3 = v0 - m_ic2eq;
+	const T v1 = a1 * m_ic1eq + a2 * v3;
+	const T v2 = m_ic2eq + a2 * m_ic1eq + a3 * v3;
+	m_ic1eq = T(2) * v1 - m_ic1eq;
+	m_ic2eq = T(2) * v2 - m_ic2eq;
+	return m0 * v0 + m1 * v1 + m2 * v2;
+}
+
+} // namespace dspbb
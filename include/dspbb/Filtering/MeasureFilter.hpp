@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Generators/Spaces.hpp"
+#include "../Kernels/Math.hpp"
 #include "../LTISystems/Systems.hpp"
 #include "../Math/FFT.hpp"
 #include "../Math/Functions.hpp"
@@ -10,6 +11,7 @@
 #include "../Primitives/SignalView.hpp"
 #include "../Utility/Numbers.hpp"
 
+#include <array>
 #include <optional>
 #include <variant>
 
@@ -463,6 +465,141 @@ auto FrequencyResponse(const BasicSignal<T, TIME_DOMAIN>& impulse, size_t gridSi
 }
 
 
+namespace impl {
+
+	namespace freqz {
+
+		template <class V>
+		struct Complex {
+			V real;
+			V imag;
+		};
+
+		template <class V>
+		Complex<V> operator*(const Complex<V>& lhs, const Complex<V>& rhs) {
+			return { lhs.real * rhs.real - lhs.imag * rhs.imag, lhs.real * rhs.imag + lhs.imag * rhs.real };
+		}
+
+		template <class V>
+		Complex<V> operator/(const Complex<V>& lhs, const Complex<V>& rhs) {
+			const V norm = rhs.real * rhs.real + rhs.imag * rhs.imag;
+			return { (lhs.real * rhs.real + lhs.imag * rhs.imag) / norm, (lhs.imag * rhs.real - lhs.real * rhs.imag) / norm };
+		}
+
+		// Horner's method with a real polynomial in ascending order.
+		template <class V, class Iter>
+		Complex<V> EvalPolynomial(Iter first, Iter last, const Complex<V>& z) {
+			Complex<V> acc = { V(0), V(0) };
+			while (first != last) {
+				--last;
+				acc = acc * z;
+				acc.real += V(*last);
+			}
+			return acc;
+		}
+
+		template <class V, class T>
+		Complex<V> Eval(const DiscreteTransferFunction<T>& sys, const Complex<V>& z) {
+			const auto num = sys.numerator.coefficients();
+			const auto den = sys.denominator.coefficients();
+			return EvalPolynomial(num.begin(), num.end(), z) / EvalPolynomial(den.begin(), den.end(), z);
+		}
+
+		template <class V, class T>
+		Complex<V> Eval(const FactoredPolynomial<T>& poly, const Complex<V>& z) {
+			const Complex<V> z2 = z * z;
+			Complex<V> acc = { V(1), V(0) };
+			for (const auto& root : poly.real_roots()) {
+				acc = acc * Complex<V>{ z.real - V(root), z.imag };
+			}
+			for (const auto& root : poly.complex_pairs()) {
+				const T a = T(-2) * root.real();
+				const T b = std::norm(root);
+				acc = acc * Complex<V>{ z2.real + V(a) * z.real + V(b), z2.imag + V(a) * z.imag };
+			}
+			return acc;
+		}
+
+		template <class V, class T>
+		Complex<V> Eval(const DiscreteZeroPoleGain<T>& sys, const Complex<V>& z) {
+			const auto response = Eval(sys.zeros, z) / Eval(sys.poles, z);
+			return { V(sys.gain) * response.real, V(sys.gain) * response.imag };
+		}
+
+		template <class V, class T>
+		Complex<V> Eval(const CascadedBiquad<T>& sys, const Complex<V>& z) {
+			// Powers of z indexed the same way as in CascadedBiquad::EvalSection.
+			const std::array<Complex<V>, 4> zs = { Complex<V>{ V(0), V(0) }, Complex<V>{ V(1), V(0) }, z, z * z };
+			Complex<V> num = { V(1), V(0) };
+			Complex<V> den = { V(1), V(0) };
+			for (const auto& section : sys.sections) {
+				const auto& n = section.numerator;
+				const auto& d = section.denominator;
+				const auto& zn1 = zs[section.numOrder];
+				const auto& zn2 = zs[1 + section.numOrder];
+				const auto& zd1 = zs[section.denOrder];
+				const auto& zd2 = zs[1 + section.denOrder];
+				num = num * Complex<V>{ V(n[0]) + V(n[1]) * zn1.real + V(n[2]) * zn2.real, V(n[1]) * zn1.imag + V(n[2]) * zn2.imag };
+				den = den * Complex<V>{ V(d[0]) + V(d[1]) * zd1.real + zd2.real, V(d[1]) * zd1.imag + zd2.imag };
+			}
+			return num / den;
+		}
+
+		template <class V, class T, class System>
+		Complex<V> EvalAt(const System& sys, const V& frequency) {
+			using namespace kernels::math_functions;
+			const V angle = frequency * V(pi_v<T>);
+			return Eval(sys, Complex<V>{ cos(angle), sin(angle) });
+		}
+
+	} // namespace freqz
+
+} // namespace impl
+
+
+/// <summary> Evaluates the complex frequency response of the system at arbitrary frequencies. </summary>
+/// <param name="out"> The complex response at each frequency. </param>
+/// <param name="frequencies"> Normalized frequencies, 1 is Nyquist. </param>
+template <class SignalR, class SignalF, class System, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalF>, int> = 0>
+void FrequencyResponse(SignalR&& out, const System& sys, const SignalF& frequencies) {
+	using T = std::remove_const_t<typename signal_traits<std::decay_t<SignalF>>::type>;
+	static_assert(!is_complex_v<T>, "Frequencies must be real.");
+	assert(out.size() == frequencies.size());
+
+	const T* first = frequencies.data();
+	const T* last = first + frequencies.size();
+	auto outIt = out.begin();
+
+	if constexpr ((xsimd::simd_traits<T>::size > 1)) {
+		using V = xsimd::batch<T>;
+		constexpr size_t vectorWidth = xsimd::simd_traits<T>::size;
+		const T* vectorLast = first + frequencies.size() / vectorWidth * vectorWidth;
+		std::array<T, vectorWidth> real;
+		std::array<T, vectorWidth> imag;
+		for (; first != vectorLast; first += vectorWidth) {
+			const auto response = impl::freqz::EvalAt<V, T>(sys, V::load_unaligned(first));
+			response.real.store_unaligned(real.data());
+			response.imag.store_unaligned(imag.data());
+			for (size_t i = 0; i < vectorWidth; ++i, ++outIt) {
+				*outIt = { real[i], imag[i] };
+			}
+		}
+	}
+	for (; first != last; ++first, ++outIt) {
+		const auto response = impl::freqz::EvalAt<T, T>(sys, *first);
+		*outIt = { response.real, response.imag };
+	}
+}
+
+template <class SignalF, class System, std::enable_if_t<is_signal_like_v<std::decay_t<SignalF>>, int> = 0>
+auto FrequencyResponse(const System& sys, const SignalF& frequencies) {
+	using T = std::remove_const_t<typename signal_traits<std::decay_t<SignalF>>::type>;
+	constexpr auto Domain = signal_traits<std::decay_t<SignalF>>::domain;
+	BasicSignal<std::complex<T>, Domain> out(frequencies.size());
+	FrequencyResponse(out, sys, frequencies);
+	return out;
+}
+
 namespace impl {
 
 	template <class T, class System>
@@ -470,19 +607,40 @@ namespace impl {
 		const size_t order = sys.order();
 		const size_t gridSize = gridSizeHint > 0 ? gridSizeHint : (1 + order) * 20;
 
-		Spectrum<T> amplitude(gridSize);
-		Spectrum<T> phase(gridSize);
+		Spectrum<T> frequencies(gridSize);
+		LinSpace(frequencies, T(0), T(1), true);
+		const auto response = dspbb::FrequencyResponse(sys, frequencies);
 
-		LinSpace(amplitude, 0.0f, pi_v<T>, true);
+		Spectrum<T> amplitude = Abs(response);
+		Spectrum<T> phase = Arg(response);
+		return { std::move(amplitude), std::move(phase) };
+	}
 
-		for (size_t i = 0; i < gridSize; ++i) {
-			const T freq = amplitude[i];
-			const std::complex<T> point = std::polar(T(1), freq);
-			const std::complex<T> response = sys(point);
-			amplitude[i] = std::abs(response);
-			phase[i] = std::arg(response);
-		}
+	template <class T>
+	auto FrequencyResponseFft(const DiscreteTransferFunction<T>& sys, size_t gridSizeHint = 0) -> std::pair<Spectrum<T>, Spectrum<T>> {
+		const size_t order = sys.order();
+		const size_t gridSize = std::max(size_t(2), gridSizeHint > 0 ? gridSizeHint : (1 + order) * 20);
+		const size_t fftSize = 2 * (gridSize - 1);
+
+		// On the roots of unity z^fftSize = 1, so the coefficients wrap around without changing the values.
+		// High order denominators lose too much precision in single precision FFTs.
+		using P = std::common_type_t<T, double>;
+		const auto wrap = [fftSize](const auto& coefficients) {
+			Signal<P> wrapped(fftSize, P(0));
+			for (size_t i = 0; i < coefficients.size(); ++i) {
+				wrapped[i % fftSize] += coefficients[i];
+			}
+			return Fft(wrapped, FFT_HALF);
+		};
+		const auto num = wrap(sys.numerator.coefficients());
+		const auto den = wrap(sys.denominator.coefficients());
+		// The polynomials are in positive powers of z, which is the conjugate of the DFT.
+		const auto response = Conj(num / den);
 
+		Spectrum<T> amplitude(gridSize);
+		Spectrum<T> phase(gridSize);
+		std::transform(response.begin(), response.end(), amplitude.begin(), [](const auto& r) { return T(std::abs(r)); });
+		std::transform(response.begin(), response.end(), phase.begin(), [](const auto& r) { return T(std::arg(r)); });
 		return { std::move(amplitude), std::move(phase) };
 	}
 
@@ -501,7 +659,7 @@ auto FrequencyResponse(const CascadedBiquad<T>& biquad, size_t gridSizeHint = 0)
 
 template <class T>
 auto FrequencyResponse(const DiscreteTransferFunction<T>& tf, size_t gridSizeHint = 0) {
-	return impl::FrequencyResponse<T>(tf, gridSizeHint);
+	return impl::FrequencyResponseFft(tf, gridSizeHint);
 }
 
 
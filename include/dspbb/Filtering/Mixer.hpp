@@ -0,0 +1,172 @@
+#pragma once
+
+#include "../Generators/Oscillators.hpp"
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalTraits.hpp"
+#include "../Primitives/SignalView.hpp"
+#include "../Utility/Numbers.hpp"
+#include "../Utility/TypeTraits.hpp"
+#include "DecimatingFir.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+
+
+namespace dspbb {
+
+//------------------------------------------------------------------------------
+// Mixer
+//------------------------------------------------------------------------------
+
+/// <summary> Shifts the frequency of a stream by multiplying it with a complex carrier. </summary>
+/// <remarks> The carrier is generated in the same pass as the multiplication and its phase continues from
+///		one block to the next. A negative frequency shifts the spectrum down. The output is complex. </remarks>
+template <class T>
+class Mixer {
+	using U = remove_complex_t<T>;
+
+public:
+	/// <param name="frequency"> The shift in Hz. </param>
+	/// <param name="phase"> The phase of the carrier at the first sample in radians. </param>
+	Mixer(uint64_t sampleRate, double frequency, double phase = 0);
+
+	/// <summary> Mixes <paramref name="input"/> into <paramref name="output"/> of the same size, which may be the same signal. </summary>
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	void process(SignalR&& output, const SignalT& input);
+	/// <summary> Restores the frequency and phase given at construction. </summary>
+	void reset();
+
+	/// <summary> Changes the frequency from the next sample on, without a jump in phase. </summary>
+	void set_frequency(double frequency);
+	/// <summary> Sets the phase of the carrier at the next sample in radians. </summary>
+	void set_phase(double phase);
+
+	double frequency() const { return m_accumulator.step * double(m_sampleRate); }
+	double phase() const { return 2.0 * pi_v<double> * m_accumulator.phase; }
+
+private:
+	uint64_t m_sampleRate;
+	double m_initialFrequency;
+	double m_initialPhase;
+	impl::PhaseAccumulator m_accumulator;
+};
+
+
+template <class T>
+Mixer<T>::Mixer(uint64_t sampleRate, double frequency, double phase)
+	: m_sampleRate(sampleRate), m_initialFrequency(frequency), m_initialPhase(phase) {
+	assert(sampleRate > 0);
+	reset();
+}
+
+template <class T>
+template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int>>
+void Mixer<T>::process(SignalR&& output, const SignalT& input) {
+	using R = typename signal_traits<std::decay_t<SignalR>>::type;
+	static_assert(is_complex_v<R>, "Output of mixing must be complex.");
+	assert(output.size() == input.size());
+
+	const auto* in = input.data();
+	auto* out = output.data();
+	m_accumulator.template Advance<U>(input.size(), [in, out](size_t index, U cycles, U) {
+		const U cosine = impl::CosCycles(cycles);
+		const U sine = impl::SinCycles(cycles);
+		if constexpr (is_complex_v<T>) {
+			const U real = U(in[index].real());
+			const U imag = U(in[index].imag());
+			out[index] = R(real * cosine - imag * sine, real * sine + imag * cosine);
+		}
+		else {
+			const U real = U(in[index]);
+			out[index] = R(real * cosine, real * sine);
+		}
+	});
+}
+
+template <class T>
+void Mixer<T>::reset() {
+	set_frequency(m_initialFrequency);
+	set_phase(m_initialPhase);
+}
+
+template <class T>
+void Mixer<T>::set_frequency(double frequency) {
+	m_accumulator.step = frequency / double(m_sampleRate);
+}
+
+template <class T>
+void Mixer<T>::set_phase(double phase) {
+	m_accumulator.phase = phase / (2.0 * pi_v<double>);
+	m_accumulator.phase -= std::floor(m_accumulator.phase);
+}
+
+
+//------------------------------------------------------------------------------
+// Downconverter
+//------------------------------------------------------------------------------
+
+/// <summary> Digital downconverter that tunes a band of a stream to DC, filters it, and decimates it. </summary>
+/// <remarks> The input is mixed down by <paramref name="centerFrequency"/> in short blocks, each of which is fed
+///		to a <see cref="StreamingDecimatingFir"/> while still in cache. To tune many equally spaced channels at
+///		once, <see cref="Channelizer"/> is cheaper. </remarks>
+template <class T, class P = remove_complex_t<T>>
+class DownConverter {
+	using U = remove_complex_t<T>;
+
+public:
+	/// <param name="filter"> The channel filter at the input rate. </param>
+	template <class SignalU>
+	DownConverter(uint64_t sampleRate, double centerFrequency, const SignalU& filter, size_t decimation);
+
+	/// <summary> Consumes all of <paramref name="input"/> and writes as many outputs as available. </summary>
+	/// <returns> The number of samples written to <paramref name="output"/>. </returns>
+	/// <remarks> Output samples that do not fit are produced by the next call. </remarks>
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	size_t process(SignalR&& output, const SignalT& input);
+	/// <summary> An upper bound on the number of outputs after feeding <paramref name="inputSize"/> samples. </summary>
+	size_t max_output_size(size_t inputSize) const { return m_decimator.max_output_size(inputSize); }
+	void reset();
+
+	/// <summary> Retunes from the next sample on, without a jump in phase. </summary>
+	void set_center_frequency(double centerFrequency) { m_mixer.set_frequency(-centerFrequency); }
+
+	double center_frequency() const { return -m_mixer.frequency(); }
+	size_t decimation() const { return m_decimator.rate(); }
+
+private:
+	static constexpr size_t blockSize = 1024;
+
+	Mixer<T> m_mixer;
+	StreamingDecimatingFir<std::complex<U>, P> m_decimator;
+	Signal<std::complex<U>> m_mixed;
+};
+
+
+template <class T, class P>
+template <class SignalU>
+DownConverter<T, P>::DownConverter(uint64_t sampleRate, double centerFrequency, const SignalU& filter, size_t decimation)
+	: m_mixer(sampleRate, -centerFrequency), m_decimator(filter, decimation), m_mixed(blockSize) {}
+
+template <class T, class P>
+template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int>>
+size_t DownConverter<T, P>::process(SignalR&& output, const SignalT& input) {
+	size_t written = 0;
+	for (size_t first = 0; first < input.size(); first += blockSize) {
+		const size_t count = std::min(blockSize, input.size() - first);
+		const auto mixed = AsView(m_mixed).subsignal(0, count);
+		m_mixer.process(mixed, AsConstView(input).subsignal(first, count));
+		written += m_decimator.process(AsView(output).subsignal(written), mixed);
+	}
+	return written;
+}
+
+template <class T, class P>
+void DownConverter<T, P>::reset() {
+	m_mixer.reset();
+	m_decimator.reset();
+}
+
+} // namespace dspbb
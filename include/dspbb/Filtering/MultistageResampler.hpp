@@ -0,0 +1,211 @@
+#pragma once
+
+#include "../Math/Rational.hpp"
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalTraits.hpp"
+#include "../Primitives/SignalView.hpp"
+#include "../Utility/TypeTraits.hpp"
+#include "FIR.hpp"
+#include "Polyphase.hpp"
+#include "Resample.hpp"
+#include "StreamingResampler.hpp"
+#include "Windowing.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+
+namespace dspbb {
+
+/// <summary> One stage of a multistage resampler. </summary>
+/// <remarks> The sample rates are in the same format as for <see cref="Resample"/>, the cutoff is normalized
+///		to the Nyquist frequency of the interpolated signal, like for <see cref="ResampleFilterCutoff"/>. </remarks>
+struct ResampleStage {
+	Rational<int64_t> sampleRates;
+	size_t numPhases;
+	size_t filterSize;
+	double cutoff;
+};
+
+
+namespace impl {
+	// Width of the transition band of a Blackman-windowed sinc, in cycles per sample, times the filter size.
+	constexpr double blackmanTransitionSize = 5.5;
+
+	/// <param name="inputRate"> The stage's input rate relative to the input of the whole chain. </param>
+	/// <param name="passbandEdge"> Edge of the band to keep relative to the input of the whole chain. </param>
+	inline ResampleStage DesignResampleStage(Rational<int64_t> sampleRates, Rational<int64_t> inputRate, double passbandEdge, size_t maxPhases) {
+		const auto [inputStep, period] = ReducedSampleRates(sampleRates);
+		const size_t numPhases = std::min(size_t(period), maxPhases);
+		const double input = double(inputRate);
+		const double output = double(inputRate / sampleRates);
+		const double interpolatedRate = input * double(numPhases);
+
+		// Everything that would alias or image into the passband must be in the stopband.
+		const double lowerRate = std::min(input, output);
+		const double transition = (lowerRate - 2.0 * passbandEdge) / interpolatedRate;
+		assert(transition > 0.0);
+		const size_t minimumSize = size_t(std::ceil(blackmanTransitionSize / transition));
+		const size_t filterSize = (minimumSize + numPhases - 1) / numPhases * numPhases + 1;
+		const double cutoff = lowerRate / interpolatedRate;
+		return { sampleRates, numPhases, filterSize, cutoff };
+	}
+} // namespace impl
+
+
+/// <summary> Splits a resampling ratio into a chain of 2x stages and at most one fractional stage. </summary>
+/// <param name="sampleRates"> Input and output sample rates, like for <see cref="Resample"/>. </param>
+/// <param name="passband"> The band to preserve as a fraction of the lower of the two Nyquist frequencies. </param>
+/// <param name="maxPhases"> The fractional stage uses at most this many phases and interpolates between them. </param>
+/// <remarks> When decimating, the 2x stages come first and the fractional stage runs at the lowest rate, when
+///		interpolating, the order is reversed. Filters are sized so that the Blackman-windowed designs keep
+///		aliases and images out of the passband. </remarks>
+inline std::vector<ResampleStage> PlanResampleStages(Rational<int64_t> sampleRates, double passband = 0.9, size_t maxPhases = 256) {
+	assert(sampleRates > 0ll);
+	assert(0.0 < passband && passband < 1.0);
+
+	// Rates are relative to the input of the chain.
+	const auto outputRate = Rational<int64_t>{ 1, 1 } / sampleRates;
+	const double passbandEdge = passband * std::min(1.0, double(outputRate)) / 2.0;
+
+	std::vector<Rational<int64_t>> ratios;
+	auto remaining = sampleRates;
+	size_t numBinary = 0;
+	if (remaining >= 2ll) {
+		for (; remaining >= 2ll; remaining /= int64_t(2)) {
+			++numBinary;
+		}
+		ratios.assign(numBinary, Rational<int64_t>{ 2, 1 });
+		if (remaining != 1ll) {
+			ratios.push_back(remaining);
+		}
+	}
+	else {
+		for (; remaining * int64_t(2) <= 1ll; remaining *= int64_t(2)) {
+			++numBinary;
+		}
+		if (remaining != 1ll) {
+			ratios.push_back(remaining);
+		}
+		ratios.insert(ratios.end(), numBinary, Rational<int64_t>{ 1, 2 });
+	}
+	if (ratios.empty()) {
+		ratios.push_back(remaining);
+	}
+
+	std::vector<ResampleStage> stages;
+	Rational<int64_t> inputRate = { 1, 1 };
+	for (const auto& ratio : ratios) {
+		stages.push_back(impl::DesignResampleStage(ratio, inputRate, passbandEdge, maxPhases));
+		inputRate /= ratio;
+	}
+	return stages;
+}
+
+
+/// <summary> Number of multiply-accumulates per output sample of the whole chain. </summary>
+inline double ResampleCost(const std::vector<ResampleStage>& stages) {
+	double outputsPerFinal = 1.0;
+	double cost = 0.0;
+	for (auto it = stages.rbegin(); it != stages.rend(); ++it) {
+		const auto [inputStep, period] = impl::ReducedSampleRates(it->sampleRates);
+		const double interpolation = size_t(period) <= it->numPhases ? 1.0 : 2.0;
+		cost += outputsPerFinal * interpolation * double(it->filterSize) / double(it->numPhases);
+		outputsPerFinal *= double(it->sampleRates);
+	}
+	return cost;
+}
+
+
+/// <summary> Resamples a stream through a chain of <see cref="StreamingResampler"/> stages. </summary>
+/// <remarks> Intermediate results stay in buffers owned by the object, which only grow when a block larger than
+///		any previous one arrives. The output is delayed by <see cref="delay"/> output samples. </remarks>
+template <class T, class P = remove_complex_t<T>>
+class MultistageResampler {
+public:
+	explicit MultistageResampler(Rational<int64_t> sampleRates, double passband = 0.9, size_t maxPhases = 256);
+	explicit MultistageResampler(const std::vector<ResampleStage>& stages);
+
+	/// <summary> Consumes all of <paramref name="input"/> and writes as many outputs as available. </summary>
+	/// <returns> The number of samples written to <paramref name="output"/>. </returns>
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	size_t process(SignalR&& output, const SignalT& input);
+	/// <summary> An upper bound on the number of outputs after feeding <paramref name="inputSize"/> samples. </summary>
+	size_t max_output_size(size_t inputSize) const;
+	void reset();
+
+	const std::vector<ResampleStage>& stages() const { return m_stages; }
+	/// <summary> The group delay of the chain in output samples. </summary>
+	double delay() const;
+
+private:
+	std::vector<ResampleStage> m_stages;
+	std::vector<StreamingResampler<T, P>> m_resamplers;
+	std::vector<Signal<T>> m_buffers;
+};
+
+
+template <class T, class P>
+MultistageResampler<T, P>::MultistageResampler(Rational<int64_t> sampleRates, double passband, size_t maxPhases)
+	: MultistageResampler(PlanResampleStages(sampleRates, passband, maxPhases)) {}
+
+template <class T, class P>
+MultistageResampler<T, P>::MultistageResampler(const std::vector<ResampleStage>& stages) : m_stages(stages) {
+	assert(!stages.empty());
+	m_resamplers.reserve(stages.size());
+	for (const auto& stage : stages) {
+		const auto filter = DesignFilter<P, TIME_DOMAIN>(stage.filterSize, Fir.Lowpass.Windowed.Cutoff(stage.cutoff).Window(windows::blackman));
+		m_resamplers.emplace_back(PolyphaseDecompose(filter, stage.numPhases), stage.sampleRates);
+	}
+	m_buffers.resize(stages.size() - 1);
+}
+
+template <class T, class P>
+template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int>>
+size_t MultistageResampler<T, P>::process(SignalR&& output, const SignalT& input) {
+	if (m_buffers.empty()) {
+		return m_resamplers.front().process(output, input);
+	}
+
+	size_t count = input.size();
+	for (size_t i = 0; i < m_buffers.size(); ++i) {
+		auto& buffer = m_buffers[i];
+		const size_t capacity = m_resamplers[i].max_output_size(count);
+		if (buffer.size() < capacity) {
+			buffer.resize(capacity);
+		}
+		count = i == 0 ? m_resamplers[i].process(buffer, input)
+					   : m_resamplers[i].process(buffer, AsConstView(m_buffers[i - 1]).subsignal(0, count));
+	}
+	return m_resamplers.back().process(output, AsConstView(m_buffers.back()).subsignal(0, count));
+}
+
+template <class T, class P>
+size_t MultistageResampler<T, P>::max_output_size(size_t inputSize) const {
+	size_t count = inputSize;
+	for (const auto& resampler : m_resamplers) {
+		count = resampler.max_output_size(count);
+	}
+	return count;
+}
+
+template <class T, class P>
+void MultistageResampler<T, P>::reset() {
+	for (auto& resampler : m_resamplers) {
+		resampler.reset();
+	}
+}
+
+template <class T, class P>
+double MultistageResampler<T, P>::delay() const {
+	// Delays of earlier stages are scaled by the rate change of the stages after them.
+	double delay = 0.0;
+	for (const auto& stage : m_stages) {
+		delay = delay / double(stage.sampleRates) + double(ResampleDelay(stage.filterSize, stage.numPhases, stage.sampleRates));
+	}
+	return delay;
+}
+
+} // namespace dspbb
@@ -1,10 +1,15 @@
 #pragma once
 
+#include "../Kernels/Utility.hpp"
 #include "../Math/Statistics.hpp"
 #include "../Primitives/Signal.hpp"
 #include "../Primitives/SignalView.hpp"
+#include "../Utility/TypeTraits.hpp"
 #include "FIR.hpp"
 
+#include <cstdint>
+#include <numeric>
+
 
 namespace dspbb {
 
@@ -87,6 +92,119 @@ private:
 	BasicSignal<T, Domain> m_buffer;
 };
 
+/// <summary> Polyphase filter bank where every phase is zero-padded to the same length. </summary>
+/// <remarks> The common length is a multiple of the SIMD width, and the phases are stored back to back in a
+///		buffer aligned to the SIMD width. Phases are reversed like in <see cref="PolyphaseView"/>, and the padding
+///		goes in front, so the bank behaves like the original filter extended with trailing zeros. </remarks>
+template <class T, eSignalDomain Domain>
+class AlignedPolyphaseFilter {
+public:
+	static constexpr size_t vector_width = xsimd::simd_traits<T>::size;
+
+	AlignedPolyphaseFilter() = default;
+	template <class U>
+	explicit AlignedPolyphaseFilter(const PolyphaseView<U, Domain>& polyphase);
+	AlignedPolyphaseFilter(const AlignedPolyphaseFilter& rhs);
+	AlignedPolyphaseFilter(AlignedPolyphaseFilter&& rhs) noexcept = default;
+	AlignedPolyphaseFilter& operator=(const AlignedPolyphaseFilter& rhs);
+	AlignedPolyphaseFilter& operator=(AlignedPolyphaseFilter&& rhs) noexcept = default;
+	~AlignedPolyphaseFilter() = default;
+
+	BasicSignalView<T, Domain> operator[](size_t index) {
+		assert(index < m_numPhases);
+		return AsView(m_buffer).subsignal(m_offset + index * m_phaseSize, m_phaseSize);
+	}
+	BasicSignalView<const T, Domain> operator[](size_t index) const {
+		assert(index < m_numPhases);
+		return AsConstView(m_buffer).subsignal(m_offset + index * m_phaseSize, m_phaseSize);
+	}
+	size_t size_per_phase() const noexcept {
+		return m_phaseSize;
+	}
+	size_t size_original() const noexcept {
+		return m_originalSize;
+	}
+	size_t num_phases() const noexcept {
+		return m_numPhases;
+	}
+
+private:
+	void allocate(size_t numPhases, size_t phaseSize, size_t originalSize);
+
+	BasicSignal<T, Domain> m_buffer;
+	size_t m_offset = 0;
+	size_t m_phaseSize = 0;
+	size_t m_originalSize = 0;
+	size_t m_numPhases = 0;
+};
+
+template <class U, eSignalDomain Domain>
+AlignedPolyphaseFilter(const PolyphaseView<U, Domain>&) -> AlignedPolyphaseFilter<std::remove_const_t<U>, Domain>;
+
+
+template <class T, eSignalDomain Domain>
+template <class U>
+AlignedPolyphaseFilter<T, Domain>::AlignedPolyphaseFilter(const PolyphaseView<U, Domain>& polyphase) {
+	const size_t phaseSize = (polyphase.size_per_phase() + vector_width - 1) / vector_width * vector_width;
+	allocate(polyphase.num_phases(), phaseSize, polyphase.size_original());
+	for (size_t i = 0; i < m_numPhases; ++i) {
+		const auto source = polyphase[i];
+		auto target = (*this)[i];
+		std::copy(source.begin(), source.end(), target.end() - source.size());
+	}
+}
+
+template <class T, eSignalDomain Domain>
+AlignedPolyphaseFilter<T, Domain>::AlignedPolyphaseFilter(const AlignedPolyphaseFilter& rhs) {
+	*this = rhs;
+}
+
+template <class T, eSignalDomain Domain>
+AlignedPolyphaseFilter<T, Domain>& AlignedPolyphaseFilter<T, Domain>::operator=(const AlignedPolyphaseFilter& rhs) {
+	if (this != &rhs) {
+		allocate(rhs.m_numPhases, rhs.m_phaseSize, rhs.m_originalSize);
+		const auto source = AsConstView(rhs.m_buffer).subsignal(rhs.m_offset, m_numPhases * m_phaseSize);
+		std::copy(source.begin(), source.end(), m_buffer.begin() + m_offset);
+	}
+	return *this;
+}
+
+template <class T, eSignalDomain Domain>
+void AlignedPolyphaseFilter<T, Domain>::allocate(size_t numPhases, size_t phaseSize, size_t originalSize) {
+	// The buffer is over-allocated by one vector so that the first phase can start on an aligned address.
+	constexpr size_t alignment = vector_width * sizeof(T);
+	m_buffer = BasicSignal<T, Domain>(numPhases * phaseSize + vector_width, T(0));
+	const auto address = reinterpret_cast<std::uintptr_t>(m_buffer.data());
+	m_offset = (alignment - address % alignment) % alignment / sizeof(T);
+	m_phaseSize = phaseSize;
+	m_originalSize = originalSize;
+	m_numPhases = numPhases;
+}
+
+
+namespace impl {
+	/// <summary> Dot product of a phase of an <see cref="AlignedPolyphaseFilter"/> and an input window of the same length. </summary>
+	template <class T, class P>
+	auto PaddedDotProduct(const T* input, const P* phase, size_t count) {
+		using R = multiplies_result_t<T, P>;
+		if constexpr (std::is_same_v<T, P> && (xsimd::simd_traits<P>::size > 1)) {
+			using V = xsimd::simd_type<P>;
+			constexpr size_t vectorWidth = xsimd::simd_traits<P>::size;
+			assert(count % vectorWidth == 0);
+			assert(reinterpret_cast<std::uintptr_t>(phase) % (vectorWidth * sizeof(P)) == 0);
+			V acc = V(P(0));
+			for (size_t i = 0; i < count; i += vectorWidth) {
+				acc = xsimd::fma(V::load_unaligned(input + i), V::load_aligned(phase + i), acc);
+			}
+			return R(xsimd::reduce_add(acc));
+		}
+		else {
+			return std::inner_product(input, input + count, phase, R(0));
+		}
+	}
+} // namespace impl
+
+
 template <class T, eSignalDomain Domain>
 void PolyphaseNormalize(PolyphaseView<T, Domain>& polyphase) {
 	for (size_t i = 0; i < polyphase.num_phases(); ++i) {
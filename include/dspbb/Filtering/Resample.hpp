@@ -6,8 +6,15 @@
 #include "../Primitives/Signal.hpp"
 #include "../Primitives/SignalTraits.hpp"
 #include "../Primitives/SignalView.hpp"
+#include "../Utility/Parallel.hpp"
 #include "Polyphase.hpp"
 
+#include <array>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace dspbb {
 
 //------------------------------------------------------------------------------
@@ -154,9 +161,145 @@ namespace impl {
 	}
 
 
+	// Coefficient j of all phases next to each other, with shorter phases padded at the front.
+	template <class P, eSignalDomain D>
+	std::vector<P> InterleavePhases(const PolyphaseView<P, D>& polyphase) {
+		const size_t rate = polyphase.num_phases();
+		const size_t phaseSize = polyphase.size_per_phase();
+		std::vector<P> coefficients(rate * phaseSize, P(0));
+		for (size_t phaseIdx = 0; phaseIdx < rate; ++phaseIdx) {
+			const auto phase = polyphase[phaseIdx];
+			const size_t padding = phaseSize - phase.size();
+			for (size_t j = 0; j < phase.size(); ++j) {
+				// Matches the conjugation of the filter by DotProduct.
+				if constexpr (is_complex_v<P>) {
+					coefficients[(padding + j) * rate + phaseIdx] = std::conj(phase[j]);
+				}
+				else {
+					coefficients[(padding + j) * rate + phaseIdx] = phase[j];
+				}
+			}
+		}
+		return coefficients;
+	}
+
+	// Each block multiplies the interleaved phases with one input window, which gives one output per phase.
+	// The products are summed in groups of 4 taps first, which keeps the rounding errors close to those of DotProduct.
+	template <class Accumulators, class OutputIt, class T, class P>
+	void InterpolateBlocks(OutputIt output, const T* input, const P* coefficients, size_t phaseSize, size_t numBlocks, Accumulators& total, Accumulators& partial) {
+		using R = typename Accumulators::value_type;
+		constexpr size_t groupSize = 4;
+		const size_t rate = total.size();
+		for (size_t block = 0; block < numBlocks; ++block, ++input) {
+			std::fill(total.begin(), total.end(), R(0));
+			const P* phaseCoefficients = coefficients;
+			for (size_t groupFirst = 0; groupFirst < phaseSize; groupFirst += groupSize) {
+				std::fill(partial.begin(), partial.end(), R(0));
+				const size_t groupLast = std::min(phaseSize, groupFirst + groupSize);
+				for (size_t j = groupFirst; j < groupLast; ++j, phaseCoefficients += rate) {
+					const T sample = input[j];
+					for (size_t phaseIdx = 0; phaseIdx < rate; ++phaseIdx) {
+						partial[phaseIdx] += sample * phaseCoefficients[phaseIdx];
+					}
+				}
+				for (size_t phaseIdx = 0; phaseIdx < rate; ++phaseIdx) {
+					total[phaseIdx] += partial[phaseIdx];
+				}
+			}
+			output = std::copy(total.begin(), total.end(), output);
+		}
+	}
+
+	template <class R, size_t Rate, class OutputIt, class T, class P>
+	void InterpolateBlocks(OutputIt output, const T* input, const P* coefficients, size_t phaseSize, size_t numBlocks) {
+		std::array<R, Rate> total;
+		std::array<R, Rate> partial;
+		InterpolateBlocks(output, input, coefficients, phaseSize, numBlocks, total, partial);
+	}
+
+	template <class R, class OutputIt, class T, class P>
+	void InterpolateBlocks(OutputIt output, const T* input, const P* coefficients, size_t phaseSize, size_t numBlocks, size_t rate) {
+		// Common rates have their accumulators in registers.
+		switch (rate) {
+			case 2: return InterpolateBlocks<R, 2>(output, input, coefficients, phaseSize, numBlocks);
+			case 3: return InterpolateBlocks<R, 3>(output, input, coefficients, phaseSize, numBlocks);
+			case 4: return InterpolateBlocks<R, 4>(output, input, coefficients, phaseSize, numBlocks);
+			case 8: return InterpolateBlocks<R, 8>(output, input, coefficients, phaseSize, numBlocks);
+			default: break;
+		}
+		std::vector<R> total(rate);
+		std::vector<R> partial(rate);
+		InterpolateBlocks(output, input, coefficients, phaseSize, numBlocks, total, partial);
+	}
+
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// Resampling schedule
+//------------------------------------------------------------------------------
+
+/// <summary> The polyphase positions visited when resampling with a fixed ratio, precomputed for one period. </summary>
+/// <remarks> Output sample n reads the input at (startPoint + n) * sampleRates. The positions repeat every
+///		reduced denominator of the sample rates outputs, while the input advances by the reduced numerator. </remarks>
+template <class T>
+class ResampleSchedule {
+public:
+	struct Entry {
+		size_t firstIndex;
+		size_t secondIndex;
+		size_t firstPhase;
+		size_t secondPhase;
+		T firstWeight;
+		T secondWeight;
+	};
+
+	ResampleSchedule() = default;
+	ResampleSchedule(size_t numPhases, Rational<int64_t> sampleRates, Rational<int64_t> startPoint = { 0, 1 });
+
+	size_t period() const { return m_entries.size(); }
+	size_t input_step() const { return m_inputStep; }
+	size_t num_phases() const { return m_numPhases; }
+	bool interpolated() const { return m_interpolated; }
+	const Entry& operator[](size_t index) const { return m_entries[index]; }
+
+private:
+	std::vector<Entry> m_entries;
+	size_t m_inputStep = 0;
+	size_t m_numPhases = 0;
+	bool m_interpolated = false;
+};
+
+
+namespace impl {
+	inline std::pair<int64_t, int64_t> ReducedSampleRates(Rational<int64_t> sampleRates) {
+		const int64_t divisor = std::gcd(sampleRates.Numerator(), sampleRates.Denominator());
+		return { sampleRates.Numerator() / divisor, sampleRates.Denominator() / divisor };
+	}
 } // namespace impl
 
 
+template <class T>
+ResampleSchedule<T>::ResampleSchedule(size_t numPhases, Rational<int64_t> sampleRates, Rational<int64_t> startPoint)
+	: m_numPhases(numPhases) {
+	assert(sampleRates > 0ll);
+	assert(startPoint >= 0ll);
+	assert(numPhases > 0);
+
+	const auto [inputStep, period] = impl::ReducedSampleRates(sampleRates);
+	m_inputStep = size_t(inputStep);
+	m_entries.reserve(period);
+	for (int64_t i = 0; i < period; ++i) {
+		const auto inputIndex = impl::ChangeSampleRate(sampleRates.Denominator(), sampleRates.Numerator(), startPoint + i);
+		const auto [first, second] = impl::InputIndex2Sample(inputIndex, numPhases);
+		const T weightSum = T(first.weight + second.weight);
+		m_entries.push_back({ first.inputIndex, second.inputIndex, first.phaseIndex, second.phaseIndex, T(first.weight) / weightSum, T(second.weight) / weightSum });
+		m_interpolated = m_interpolated || second.weight != 0;
+	}
+}
+
+
 //------------------------------------------------------------------------------
 // Expansion & Interpolation & Resampling
 //------------------------------------------------------------------------------
@@ -215,6 +358,95 @@ auto Expand(const SignalT& input, size_t rate) {
 }
 
 
+namespace impl {
+	// The blocks of all phases whose outputs lie in [hrFirst, hrLast) and read only the inside of the input.
+	template <class P, eSignalDomain D>
+	std::pair<size_t, size_t> InterpolBlockRange(const PolyphaseView<P, D>& polyphase, size_t lrInputSize, size_t hrFirst, size_t hrLast) {
+		const size_t rate = polyphase.num_phases();
+		const size_t blockFirst = std::max(polyphase.size_per_phase() - 1, (hrFirst + rate - 1) / rate);
+		const size_t blockLast = std::max(blockFirst, std::min(lrInputSize, hrLast / rate));
+		return { blockFirst, blockLast };
+	}
+
+	// The interleaved phases for the block kernel, or none when there are fewer blocks than taps per phase,
+	// and interleaving would cost more than the blocks save.
+	template <class P, eSignalDomain D>
+	std::vector<P> InterpolBlockCoefficients(const PolyphaseView<P, D>& polyphase, size_t lrInputSize, size_t hrFirst, size_t hrLast) {
+		const auto [blockFirst, blockLast] = InterpolBlockRange(polyphase, lrInputSize, hrFirst, hrLast);
+		if (blockLast - blockFirst < polyphase.size_per_phase()) {
+			return {};
+		}
+		return InterleavePhases(polyphase);
+	}
+
+	// Interpolates with the block kernel if coefficients has the interleaved phases, or sample by sample otherwise.
+	template <class SignalR, class SignalT, class P, eSignalDomain D>
+	InterpolSuspensionPoint InterpolateWithBlocks(SignalR&& hrOutput,
+												  const SignalT& lrInput,
+												  const PolyphaseView<P, D>& polyphase,
+												  size_t hrOffset,
+												  const std::vector<P>& coefficients) {
+		const ptrdiff_t rate = polyphase.num_phases();
+		const ptrdiff_t hrFilterSize = polyphase.size_original();
+		const ptrdiff_t lrPhaseSize = polyphase.size_per_phase();
+		const ptrdiff_t hrOutputSize = hrOutput.size();
+
+		const ptrdiff_t hrOutputMaxSize = InterpolLength(lrInput.size(), hrFilterSize, rate, CONV_FULL);
+		assert(ptrdiff_t(hrOffset) + hrOutputSize <= hrOutputMaxSize);
+
+		const auto interpolateSample = [&](size_t hrOutputIdx) {
+			const ptrdiff_t hrInputIdx = 1 - hrFilterSize + hrOutputIdx;
+			const ptrdiff_t lrInputIdx = (hrInputIdx + hrFilterSize - 1) / rate - lrPhaseSize + 1;
+			const ptrdiff_t polyphaseIdx = (hrInputIdx + hrFilterSize - 1) % rate;
+
+			const auto& phase = polyphase[polyphaseIdx];
+
+			const Interval inputSpan = { ptrdiff_t(0), ptrdiff_t(lrInput.size()) };
+			const Interval lrInputInterval = { lrInputIdx, lrInputIdx + lrPhaseSize };
+			const Interval lrPhaseInterval = { lrInputInterval.last - ptrdiff_t(phase.size()), lrInputInterval.last };
+			const Interval lrInputProductInterval = Intersection(inputSpan, Intersection(lrInputInterval, lrPhaseInterval));
+			const Interval lrPhaseProductInterval = lrInputProductInterval - lrInputIdx;
+
+			if (lrInputProductInterval.size() > 0) {
+				const auto lrInputView = AsView(lrInput).subsignal(lrInputProductInterval.first,
+																   lrInputProductInterval.last - lrInputProductInterval.first);
+				const auto lrPhaseView = phase.subsignal(lrPhaseProductInterval.first - lrPhaseSize + ptrdiff_t(phase.size()),
+														 lrPhaseProductInterval.last - lrPhaseProductInterval.first);
+				const auto value = DotProduct(lrInputView, lrPhaseView);
+				hrOutput[hrOutputIdx - hrOffset] = value;
+			}
+		};
+
+		// Whole blocks of rate outputs that only read the inside of the input are computed together.
+		const size_t hrLast = hrOffset + hrOutputSize;
+		const auto [blockFirst, blockLast] = InterpolBlockRange(polyphase, lrInput.size(), hrOffset, hrLast);
+		const bool useBlocks = !coefficients.empty() && blockFirst < blockLast;
+		const size_t interiorFirst = useBlocks ? blockFirst * rate : hrLast;
+		const size_t interiorLast = useBlocks ? blockLast * rate : hrLast;
+
+		for (size_t hrOutputIdx = hrOffset; hrOutputIdx < interiorFirst; ++hrOutputIdx) {
+			interpolateSample(hrOutputIdx);
+		}
+		if (interiorFirst < interiorLast) {
+			using T = std::remove_const_t<typename signal_traits<std::decay_t<SignalT>>::type>;
+			using R = multiplies_result_t<T, P>;
+			InterpolateBlocks<R>(hrOutput.begin() + (interiorFirst - hrOffset),
+								 lrInput.data() + blockFirst + 1 - lrPhaseSize,
+								 coefficients.data(),
+								 size_t(lrPhaseSize),
+								 blockLast - blockFirst,
+								 size_t(rate));
+		}
+		for (size_t hrOutputIdx = interiorLast; hrOutputIdx < hrLast; ++hrOutputIdx) {
+			interpolateSample(hrOutputIdx);
+		}
+
+		return FindInterpolSuspensionPoint(hrLast, polyphase.size_original(), polyphase.num_phases());
+	}
+
+} // namespace impl
+
+
 template <class SignalR,
 		  class SignalT,
 		  class P,
@@ -224,39 +456,94 @@ InterpolSuspensionPoint Interpolate(SignalR&& hrOutput,
 									const SignalT& lrInput,
 									const PolyphaseView<P, D>& polyphase,
 									size_t hrOffset) {
-	const ptrdiff_t rate = polyphase.num_phases();
-	const ptrdiff_t hrFilterSize = polyphase.size_original();
-	const ptrdiff_t lrPhaseSize = polyphase.size_per_phase();
-	const ptrdiff_t hrOutputSize = hrOutput.size();
-
-	const ptrdiff_t hrOutputMaxSize = InterpolLength(lrInput.size(), hrFilterSize, rate, CONV_FULL);
-	assert(ptrdiff_t(hrOffset) + hrOutputSize <= hrOutputMaxSize);
-
-	size_t hrOutputIdx = hrOffset;
-	for (; hrOutputIdx < hrOffset + hrOutputSize; ++hrOutputIdx) {
-		const ptrdiff_t hrInputIdx = 1 - hrFilterSize + hrOutputIdx;
-		const ptrdiff_t lrInputIdx = (hrInputIdx + hrFilterSize - 1) / rate - lrPhaseSize + 1;
-		const ptrdiff_t polyphaseIdx = (hrInputIdx + hrFilterSize - 1) % rate;
-
-		const auto& phase = polyphase[polyphaseIdx];
-
-		const Interval inputSpan = { ptrdiff_t(0), ptrdiff_t(lrInput.size()) };
-		const Interval lrInputInterval = { lrInputIdx, lrInputIdx + lrPhaseSize };
-		const Interval lrPhaseInterval = { lrInputInterval.last - ptrdiff_t(phase.size()), lrInputInterval.last };
-		const Interval lrInputProductInterval = Intersection(inputSpan, Intersection(lrInputInterval, lrPhaseInterval));
-		const Interval lrPhaseProductInterval = lrInputProductInterval - lrInputIdx;
-
-		if (lrInputProductInterval.size() > 0) {
-			const auto lrInputView = AsView(lrInput).subsignal(lrInputProductInterval.first,
-															   lrInputProductInterval.last - lrInputProductInterval.first);
-			const auto lrPhaseView = phase.subsignal(lrPhaseProductInterval.first - lrPhaseSize + ptrdiff_t(phase.size()),
-													 lrPhaseProductInterval.last - lrPhaseProductInterval.first);
-			const auto value = DotProduct(lrInputView, lrPhaseView);
-			hrOutput[hrOutputIdx - hrOffset] = value;
-		}
+	const auto coefficients = impl::InterpolBlockCoefficients(polyphase, lrInput.size(), hrOffset, hrOffset + hrOutput.size());
+	return impl::InterpolateWithBlocks(hrOutput, lrInput, polyphase, hrOffset, coefficients);
+}
+
+
+/// <summary> Interpolates using a zero-padded filter bank. </summary>
+/// <remarks> Produces the same samples as the <see cref="PolyphaseView"/> overload. </remarks>
+template <class SignalR,
+		  class SignalT,
+		  class P,
+		  eSignalDomain D,
+		  std::enable_if_t<is_same_domain_v<SignalR, SignalT, BasicSignal<P, D>> && is_mutable_signal_v<SignalR>, int> = 0>
+InterpolSuspensionPoint Interpolate(SignalR&& hrOutput,
+									const SignalT& lrInput,
+									const AlignedPolyphaseFilter<P, D>& polyphase,
+									size_t hrOffset) {
+	const size_t rate = polyphase.num_phases();
+	const size_t phaseSize = polyphase.size_per_phase();
+	const size_t hrLast = hrOffset + hrOutput.size();
+	assert(hrLast <= InterpolLength(lrInput.size(), polyphase.size_original(), rate, CONV_FULL));
+
+	// High-rate output sample i is phase i % rate applied to the low-rate input ending at i / rate.
+	const size_t interiorFirst = std::min(hrLast, std::max(hrOffset, (phaseSize - 1) * rate));
+	const size_t interiorLast = std::max(interiorFirst, std::min(hrLast, lrInput.size() * rate));
+
+	auto outputIt = hrOutput.begin();
+	for (size_t hrOutputIdx = hrOffset; hrOutputIdx < interiorFirst; ++hrOutputIdx, ++outputIt) {
+		*outputIt = impl::DotProductSample(lrInput, polyphase[hrOutputIdx % rate], hrOutputIdx / rate);
+	}
+	for (size_t hrOutputIdx = interiorFirst; hrOutputIdx < interiorLast; ++hrOutputIdx, ++outputIt) {
+		const size_t lrInputIdx = hrOutputIdx / rate + 1 - phaseSize;
+		*outputIt = impl::PaddedDotProduct(lrInput.data() + lrInputIdx, polyphase[hrOutputIdx % rate].data(), phaseSize);
+	}
+	for (size_t hrOutputIdx = interiorLast; hrOutputIdx < hrLast; ++hrOutputIdx, ++outputIt) {
+		*outputIt = impl::DotProductSample(lrInput, polyphase[hrOutputIdx % rate], hrOutputIdx / rate);
 	}
 
-	return impl::FindInterpolSuspensionPoint(hrOutputIdx, polyphase.size_original(), polyphase.num_phases());
+	return impl::FindInterpolSuspensionPoint(hrLast, polyphase.size_original(), rate);
+}
+
+
+namespace impl {
+	template <class P, eSignalDomain D>
+	std::true_type IsPolyphaseView(const PolyphaseView<P, D>*);
+	std::false_type IsPolyphaseView(const void*);
+
+	template <class Polyphase>
+	constexpr bool is_polyphase_view_v = decltype(IsPolyphaseView(std::declval<const Polyphase*>()))::value;
+} // namespace impl
+
+
+/// <summary> Interpolates on <paramref name="numThreads"/> threads, each writing a separate range of the output. </summary>
+/// <remarks> Produces the same samples as the single-threaded overload for the same filter bank. The ranges
+///		are split at multiples of the rate, so that each thread computes the same blocks of all phases, and
+///		the filter bank is prepared for the block kernel once for all threads. </remarks>
+template <class SignalR,
+		  class SignalT,
+		  class Polyphase,
+		  std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+InterpolSuspensionPoint Interpolate(SignalR&& hrOutput,
+									const SignalT& lrInput,
+									const Polyphase& polyphase,
+									size_t hrOffset,
+									size_t numThreads) {
+	const size_t rate = polyphase.num_phases();
+	const size_t hrLast = hrOffset + hrOutput.size();
+	const size_t firstBlock = hrOffset / rate;
+	const size_t numBlocks = hrOutput.empty() ? 0 : (hrLast + rate - 1) / rate - firstBlock;
+	const auto forEachRange = [&hrOutput, numBlocks, numThreads, hrOffset, hrLast, rate, firstBlock](const auto& interpolate) {
+		impl::ParallelFor(numBlocks, numThreads, [&](size_t first, size_t last) {
+			const size_t hrFirst = std::max(hrOffset, (firstBlock + first) * rate);
+			const size_t hrRangeLast = std::min(hrLast, (firstBlock + last) * rate);
+			interpolate(AsView(hrOutput).subsignal(hrFirst - hrOffset, hrRangeLast - hrFirst), hrFirst);
+		});
+	};
+	if constexpr (impl::is_polyphase_view_v<Polyphase>) {
+		// The threads share the interleaved phases, and all take the block kernel if the whole output would.
+		const auto coefficients = impl::InterpolBlockCoefficients(polyphase, lrInput.size(), hrOffset, hrLast);
+		forEachRange([&lrInput, &polyphase, &coefficients](auto&& output, size_t hrFirst) {
+			impl::InterpolateWithBlocks(output, lrInput, polyphase, hrFirst, coefficients);
+		});
+	}
+	else {
+		forEachRange([&lrInput, &polyphase](auto&& output, size_t hrFirst) {
+			Interpolate(output, lrInput, polyphase, hrFirst);
+		});
+	}
+	return impl::FindInterpolSuspensionPoint(hrLast, polyphase.size_original(), rate);
 }
 
 
@@ -274,6 +561,141 @@ auto Interpolate(const SignalT& lrInput,
 }
 
 
+namespace impl {
+	template <class SignalR, class SignalT, class Polyphase, class W, class InteriorProduct>
+	size_t ResampleScheduled(SignalR& output,
+							 const SignalT& input,
+							 const Polyphase& polyphase,
+							 const ResampleSchedule<W>& schedule,
+							 size_t firstOutput,
+							 InteriorProduct dotProduct) {
+		assert(schedule.num_phases() == polyphase.num_phases());
+
+		const size_t period = schedule.period();
+		const size_t inputStep = schedule.input_step();
+		const size_t phaseSize = polyphase.size_per_phase();
+
+		size_t entryIndex = firstOutput % period;
+		size_t inputBase = firstOutput / period * inputStep;
+		auto outputIt = output.begin();
+		const auto outputLast = output.end();
+
+		const auto advance = [&] {
+			++outputIt;
+			if (++entryIndex == period) {
+				entryIndex = 0;
+				inputBase += inputStep;
+			}
+		};
+		const auto sampleEdge = [&] {
+			const auto& entry = schedule[entryIndex];
+			const auto first = impl::DotProductSample(input, polyphase[entry.firstPhase], inputBase + entry.firstIndex);
+			const auto second = impl::DotProductSample(input, polyphase[entry.secondPhase], inputBase + entry.secondIndex);
+			using CommonType = decltype(first);
+			*outputIt = first * CommonType(entry.firstWeight) + second * CommonType(entry.secondWeight);
+		};
+		const auto isInterior = [&] {
+			const auto& entry = schedule[entryIndex];
+			return inputBase + entry.firstIndex + 1 >= phaseSize && inputBase + entry.secondIndex < input.size();
+		};
+
+		// Leading edge: the filter hangs over the beginning of the input.
+		for (; outputIt != outputLast && !isInterior(); advance()) {
+			sampleEdge();
+		}
+		// Interior: the whole filter overlaps the input, no bounds checks needed.
+		if (schedule.interpolated()) {
+			for (; outputIt != outputLast && inputBase + schedule[entryIndex].secondIndex < input.size(); advance()) {
+				const auto& entry = schedule[entryIndex];
+				const auto first = dotProduct(entry.firstPhase, inputBase + entry.firstIndex);
+				const auto second = dotProduct(entry.secondPhase, inputBase + entry.secondIndex);
+				using CommonType = decltype(first);
+				*outputIt = first * CommonType(entry.firstWeight) + second * CommonType(entry.secondWeight);
+			}
+		}
+		else {
+			for (; outputIt != outputLast && inputBase + schedule[entryIndex].firstIndex < input.size(); advance()) {
+				const auto& entry = schedule[entryIndex];
+				*outputIt = dotProduct(entry.firstPhase, inputBase + entry.firstIndex);
+			}
+		}
+		// Trailing edge: the filter hangs over the end of the input.
+		for (; outputIt != outputLast; advance()) {
+			sampleEdge();
+		}
+
+		return firstOutput + output.size();
+	}
+} // namespace impl
+
+
+/// <summary> Resamples using a precomputed schedule, starting at output sample <paramref name="firstOutput"/>
+///		of the schedule. </summary>
+/// <returns> The index of the next output sample, to continue from. </returns>
+template <class SignalR,
+		  class SignalT,
+		  class P,
+		  eSignalDomain D,
+		  class W,
+		  std::enable_if_t<is_same_domain_v<SignalR, SignalT, BasicSignal<P, D>> && is_mutable_signal_v<SignalR>, int> = 0>
+size_t Resample(SignalR&& output,
+				const SignalT& input,
+				const PolyphaseView<P, D>& polyphase,
+				const ResampleSchedule<W>& schedule,
+				size_t firstOutput = 0) {
+	const auto dotProduct = [&input, &polyphase](size_t phaseIndex, size_t inputIndex) {
+		const auto phase = polyphase[phaseIndex];
+		return DotProduct(AsConstView(input).subsignal(inputIndex + 1 - phase.size(), phase.size()), phase);
+	};
+	return impl::ResampleScheduled(output, input, polyphase, schedule, firstOutput, dotProduct);
+}
+
+
+/// <summary> Resamples using a precomputed schedule and a zero-padded filter bank. </summary>
+/// <returns> The index of the next output sample, to continue from. </returns>
+template <class SignalR,
+		  class SignalT,
+		  class P,
+		  eSignalDomain D,
+		  class W,
+		  std::enable_if_t<is_same_domain_v<SignalR, SignalT, BasicSignal<P, D>> && is_mutable_signal_v<SignalR>, int> = 0>
+size_t Resample(SignalR&& output,
+				const SignalT& input,
+				const AlignedPolyphaseFilter<P, D>& polyphase,
+				const ResampleSchedule<W>& schedule,
+				size_t firstOutput = 0) {
+	const size_t phaseSize = polyphase.size_per_phase();
+	const auto dotProduct = [&input, &polyphase, phaseSize](size_t phaseIndex, size_t inputIndex) {
+		return impl::PaddedDotProduct(input.data() + inputIndex + 1 - phaseSize, polyphase[phaseIndex].data(), phaseSize);
+	};
+	return impl::ResampleScheduled(output, input, polyphase, schedule, firstOutput, dotProduct);
+}
+
+
+template <class SignalR,
+		  class SignalT,
+		  class P,
+		  eSignalDomain D,
+		  std::enable_if_t<is_same_domain_v<SignalR, SignalT, BasicSignal<P, D>> && is_mutable_signal_v<SignalR>, int> = 0>
+ResampleSuspensionPoint Resample(SignalR&& output,
+								 const SignalT& input,
+								 const AlignedPolyphaseFilter<P, D>& polyphase,
+								 Rational<int64_t> sampleRates,
+								 Rational<int64_t> startPoint = { 0, 1 }) {
+	assert(sampleRates >= 0ll);
+	assert(startPoint >= 0ll);
+	assert(polyphase.num_phases() > 0);
+
+	[[maybe_unused]] const auto maxLength = ResampleLength(input.size(), polyphase.size_original(), polyphase.num_phases(), sampleRates, CONV_FULL);
+	assert(startPoint + int64_t(output.size()) <= maxLength);
+
+	using W = remove_complex_t<typename signal_traits<std::decay_t<SignalR>>::type>;
+	const ResampleSchedule<W> schedule{ polyphase.num_phases(), sampleRates, startPoint };
+	Resample(output, input, polyphase, schedule);
+	return impl::FindResampleSuspensionPoint(startPoint + int64_t(output.size()), polyphase.size_original(), polyphase.num_phases(), sampleRates);
+}
+
+
 template <class SignalR,
 		  class SignalT,
 		  class P,
@@ -291,6 +713,15 @@ ResampleSuspensionPoint Resample(SignalR&& output,
 	[[maybe_unused]] const auto maxLength = ResampleLength(input.size(), polyphase.size_original(), polyphase.num_phases(), sampleRates, CONV_FULL);
 	assert(startPoint + int64_t(output.size()) <= maxLength);
 
+	// Building the schedule costs as much as computing its period of outputs the slow way.
+	const auto [inputStep, period] = impl::ReducedSampleRates(sampleRates);
+	if (size_t(period) <= output.size()) {
+		using W = remove_complex_t<typename signal_traits<std::decay_t<SignalR>>::type>;
+		const ResampleSchedule<W> schedule{ polyphase.num_phases(), sampleRates, startPoint };
+		Resample(output, input, polyphase, schedule);
+		return impl::FindResampleSuspensionPoint(startPoint + int64_t(output.size()), polyphase.size_original(), polyphase.num_phases(), sampleRates);
+	}
+
 	auto outputIndex = startPoint;
 	for (auto outputIt = output.begin(); outputIt != output.end(); ++outputIt, outputIndex += 1) {
 		const auto inputIndex = impl::ChangeSampleRate(sampleRates.Denominator(), sampleRates.Numerator(), outputIndex);
@@ -306,6 +737,26 @@ ResampleSuspensionPoint Resample(SignalR&& output,
 }
 
 
+/// <summary> Resamples on <paramref name="numThreads"/> threads, each writing a separate range of the output. </summary>
+/// <remarks> The ranges start at fractional input positions, just like continuing from a suspension point. </remarks>
+template <class SignalR,
+		  class SignalT,
+		  class Polyphase,
+		  std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+ResampleSuspensionPoint Resample(SignalR&& output,
+								 const SignalT& input,
+								 const Polyphase& polyphase,
+								 Rational<int64_t> sampleRates,
+								 Rational<int64_t> startPoint,
+								 size_t numThreads) {
+	const auto resampleRange = [&output, &input, &polyphase, sampleRates, startPoint](size_t first, size_t last) {
+		Resample(AsView(output).subsignal(first, last - first), input, polyphase, sampleRates, startPoint + int64_t(first));
+	};
+	impl::ParallelFor(output.size(), numThreads, resampleRange);
+	return impl::FindResampleSuspensionPoint(startPoint + int64_t(output.size()), polyphase.size_original(), polyphase.num_phases(), sampleRates);
+}
+
+
 template <class SignalT,
 		  class P,
 		  eSignalDomain Domain,
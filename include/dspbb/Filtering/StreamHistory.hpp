@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalView.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+
+namespace dspbb {
+
+namespace impl {
+	/// <summary> Input history of a streaming filter, addressed by absolute input sample index. </summary>
+	/// <remarks> The samples are kept in a linear buffer that is compacted only when it runs out of space, so
+	///		windows are always contiguous. The input is preceded by <paramref name="history"/> zeros. </remarks>
+	template <class T>
+	class StreamHistory {
+	public:
+		explicit StreamHistory(size_t history = 0) : m_history(history), m_buffer(4 * (history + 1)) { reset(); }
+
+		void reset() {
+			std::fill(m_buffer.begin(), m_buffer.begin() + m_history, T(0));
+			m_bufferFirst = 0;
+			m_bufferLast = m_history;
+			m_bufferOrigin = -int64_t(m_history);
+			m_inputCount = 0;
+		}
+
+		template <class SignalT>
+		void append(const SignalT& input) {
+			if (m_bufferLast + input.size() > m_buffer.size()) {
+				std::copy(m_buffer.begin() + m_bufferFirst, m_buffer.begin() + m_bufferLast, m_buffer.begin());
+				m_bufferOrigin += int64_t(m_bufferFirst);
+				m_bufferLast -= m_bufferFirst;
+				m_bufferFirst = 0;
+				if (m_bufferLast + input.size() > m_buffer.size()) {
+					m_buffer.resize(2 * (m_bufferLast + input.size()));
+				}
+			}
+			std::copy(input.begin(), input.end(), m_buffer.begin() + m_bufferLast);
+			m_bufferLast += input.size();
+			m_inputCount += int64_t(input.size());
+		}
+
+		/// <summary> Samples before <paramref name="firstNeeded"/> may be dropped. </summary>
+		void release(int64_t firstNeeded) {
+			const int64_t firstDiscard = std::max(int64_t(0), firstNeeded - m_bufferOrigin);
+			m_bufferFirst = std::min(m_bufferLast, std::max(m_bufferFirst, size_t(firstDiscard)));
+		}
+
+		/// <summary> The <paramref name="size"/> samples ending at <paramref name="lastIndex"/>, inclusive. </summary>
+		BasicSignalView<const T, TIME_DOMAIN> window(int64_t lastIndex, size_t size) const {
+			const size_t last = size_t(lastIndex - m_bufferOrigin) + 1;
+			assert(last >= size + m_bufferFirst && last <= m_bufferLast);
+			return AsConstView(m_buffer).subsignal(last - size, size);
+		}
+
+		/// <summary> The number of samples appended since the last reset. </summary>
+		int64_t size() const { return m_inputCount; }
+
+	private:
+		size_t m_history = 0;
+		Signal<T> m_buffer;
+		size_t m_bufferFirst = 0;
+		size_t m_bufferLast = 0;
+		int64_t m_bufferOrigin = 0;
+		int64_t m_inputCount = 0;
+	};
+} // namespace impl
+
+} // namespace dspbb
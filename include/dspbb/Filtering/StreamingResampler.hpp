@@ -0,0 +1,117 @@
+#pragma once
+
+#include "../Math/DotProduct.hpp"
+#include "../Math/Rational.hpp"
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalTraits.hpp"
+#include "../Primitives/SignalView.hpp"
+#include "../Utility/TypeTraits.hpp"
+#include "Polyphase.hpp"
+#include "Resample.hpp"
+#include "StreamHistory.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace dspbb {
+
+/// <summary> Resamples a stream block by block with a fixed ratio. </summary>
+/// <remarks> The output is identical to resampling the concatenated input with <see cref="Resample"/> from
+///		the start of the full convolution. The resampler keeps the input history in a sliding buffer that is
+///		compacted only when it runs out of space, so processing does not allocate once the buffer has grown
+///		to the largest block size. </remarks>
+template <class T, class P = remove_complex_t<T>>
+class StreamingResampler {
+public:
+	StreamingResampler(PolyphaseFilter<P, TIME_DOMAIN> polyphase, Rational<int64_t> sampleRates);
+
+	/// <summary> Consumes all of <paramref name="input"/> and writes as many outputs as available. </summary>
+	/// <returns> The number of samples written to <paramref name="output"/>. </returns>
+	/// <remarks> Output samples that do not fit are produced by the next call. </remarks>
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	size_t process(SignalR&& output, const SignalT& input);
+	/// <summary> An upper bound on the number of outputs after feeding <paramref name="inputSize"/> samples. </summary>
+	size_t max_output_size(size_t inputSize) const;
+	void reset();
+
+	const PolyphaseFilter<P, TIME_DOMAIN>& polyphase() const { return m_polyphase; }
+	Rational<int64_t> sample_rates() const { return m_sampleRates; }
+
+private:
+	T sample(int64_t inputIndex, size_t phaseIndex) const;
+
+	PolyphaseFilter<P, TIME_DOMAIN> m_polyphase;
+	Rational<int64_t> m_sampleRates;
+	ResampleSchedule<remove_complex_t<T>> m_schedule;
+	size_t m_history = 0;
+	impl::StreamHistory<T> m_input;
+
+	size_t m_entryIndex = 0;
+	int64_t m_inputBase = 0;
+};
+
+
+template <class T, class P>
+StreamingResampler<T, P>::StreamingResampler(PolyphaseFilter<P, TIME_DOMAIN> polyphase, Rational<int64_t> sampleRates)
+	: m_polyphase(std::move(polyphase)),
+	  m_sampleRates(sampleRates),
+	  m_schedule(m_polyphase.num_phases(), sampleRates),
+	  m_history(m_polyphase.size_per_phase() - 1),
+	  m_input(m_history) {}
+
+template <class T, class P>
+template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int>>
+size_t StreamingResampler<T, P>::process(SignalR&& output, const SignalT& input) {
+	m_input.append(input);
+
+	const size_t period = m_schedule.period();
+	const int64_t inputStep = int64_t(m_schedule.input_step());
+	const bool interpolated = m_schedule.interpolated();
+
+	size_t count = 0;
+	for (; count < output.size(); ++count) {
+		const auto& entry = m_schedule[m_entryIndex];
+		const int64_t secondIndex = m_inputBase + int64_t(entry.secondIndex);
+		const int64_t firstIndex = m_inputBase + int64_t(entry.firstIndex);
+		if ((interpolated ? secondIndex : firstIndex) >= m_input.size()) {
+			break;
+		}
+		if (interpolated) {
+			output[count] = sample(firstIndex, entry.firstPhase) * T(entry.firstWeight)
+							+ sample(secondIndex, entry.secondPhase) * T(entry.secondWeight);
+		}
+		else {
+			output[count] = sample(firstIndex, entry.firstPhase);
+		}
+		if (++m_entryIndex == period) {
+			m_entryIndex = 0;
+			m_inputBase += inputStep;
+		}
+	}
+
+	m_input.release(m_inputBase + int64_t(m_schedule[m_entryIndex].firstIndex) - int64_t(m_history));
+	return count;
+}
+
+template <class T, class P>
+size_t StreamingResampler<T, P>::max_output_size(size_t inputSize) const {
+	const auto [inputStep, period] = impl::ReducedSampleRates(m_sampleRates);
+	const int64_t available = m_input.size() + int64_t(inputSize) - m_inputBase;
+	return size_t(std::max(int64_t(0), available) * period / inputStep + period + 1);
+}
+
+template <class T, class P>
+void StreamingResampler<T, P>::reset() {
+	m_input.reset();
+	m_entryIndex = 0;
+	m_inputBase = 0;
+}
+
+template <class T, class P>
+T StreamingResampler<T, P>::sample(int64_t inputIndex, size_t phaseIndex) const {
+	const auto phase = m_polyphase[phaseIndex];
+	return T(DotProduct(m_input.window(inputIndex, phase.size()), phase));
+}
+
+} // namespace dspbb
@@ -0,0 +1,353 @@
+#pragma once
+
+#include "../Math/Functions.hpp"
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalView.hpp"
+#include "../Utility/Parallel.hpp"
+#include "../Utility/TypeTraits.hpp"
+#include "Oscillators.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace dspbb {
+
+
+namespace impl {
+
+	// Philox4x32-10 from Salmon et al., "Parallel random numbers: as easy as 1, 2, 3". The output is a function
+	// of the counter and the key alone, so any part of a random stream can be generated independently.
+	inline std::array<uint32_t, 4> Philox4x32(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key) {
+		constexpr uint32_t multiplier0 = 0xD2511F53;
+		constexpr uint32_t multiplier1 = 0xCD9E8D57;
+		constexpr uint32_t weyl0 = 0x9E3779B9;
+		constexpr uint32_t weyl1 = 0xBB67AE85;
+		for (int round = 0; round < 10; ++round) {
+			const uint64_t product0 = uint64_t(multiplier0) * counter[0];
+			const uint64_t product1 = uint64_t(multiplier1) * counter[2];
+			counter = { uint32_t(product1 >> 32) ^ counter[1] ^ key[0],
+						uint32_t(product1),
+						uint32_t(product0 >> 32) ^ counter[3] ^ key[1],
+						uint32_t(product0) };
+			key[0] += weyl0;
+			key[1] += weyl1;
+		}
+		return counter;
+	}
+
+	// Writes the 4 words of blocks first, first + 1, ..., first + count - 1. The blocks are independent, so the
+	// loop vectorizes across them.
+	inline void PhiloxBlocks(uint32_t* words, uint64_t first, size_t count, std::array<uint32_t, 2> key) {
+		for (size_t i = 0; i < count; ++i) {
+			const uint64_t block = first + i;
+			const auto result = Philox4x32({ uint32_t(block), uint32_t(block >> 32), 0, 0 }, key);
+			for (size_t word = 0; word < 4; ++word) {
+				words[4 * i + word] = result[word];
+			}
+		}
+	}
+
+	inline std::array<uint32_t, 2> PhiloxKey(uint64_t seed) {
+		return { uint32_t(seed), uint32_t(seed >> 32) };
+	}
+
+	// Each block of 4 random words makes 4 float or 2 double samples.
+	template <class T>
+	constexpr size_t noiseSamplesPerBlock = sizeof(T) <= 4 ? 4 : 2;
+
+	// Uniform in [0, 1) from the high bits of one word for floats and of two words for doubles. The conversions
+	// go through signed 32 bit integers, which vectorize.
+	template <class T>
+	void UniformFromWords(T* output, const uint32_t* words, size_t numBlocks) {
+		if constexpr (noiseSamplesPerBlock<T> == 4) {
+			for (size_t i = 0; i < 4 * numBlocks; ++i) {
+				output[i] = T(int32_t(words[i] >> 8)) * T(1.0 / 16777216.0);
+			}
+		}
+		else {
+			for (size_t i = 0; i < 2 * numBlocks; ++i) {
+				const T high = T(int32_t(words[2 * i] >> 5));
+				const T low = T(int32_t(words[2 * i + 1] >> 6));
+				output[i] = (high * T(67108864.0) + low) * T(1.0 / 9007199254740992.0);
+			}
+		}
+	}
+
+	// Standard normal samples by the Box-Muller transform, one pair from two uniforms.
+	template <class T>
+	void GaussianFromWords(T* output, const uint32_t* words, size_t numBlocks) {
+		constexpr size_t maxPairs = 128;
+		std::array<T, maxPairs> radii;
+		std::array<T, maxPairs> angles;
+		const size_t numPairs = noiseSamplesPerBlock<T> / 2 * numBlocks;
+		assert(numPairs <= maxPairs);
+
+		// The radius uniform is in (0, 1] to keep the logarithm finite.
+		if constexpr (noiseSamplesPerBlock<T> == 4) {
+			for (size_t i = 0; i < numPairs; ++i) {
+				radii[i] = (T(int32_t(words[2 * i] >> 8)) + T(1)) * T(1.0 / 16777216.0);
+				angles[i] = T(int32_t(words[2 * i + 1] >> 8)) * T(1.0 / 16777216.0);
+			}
+		}
+		else {
+			for (size_t i = 0; i < numPairs; ++i) {
+				const T high = T(int32_t(words[4 * i] >> 5));
+				const T low = T(int32_t(words[4 * i + 1] >> 6));
+				radii[i] = (high * T(67108864.0) + low + T(1)) * T(1.0 / 9007199254740992.0);
+				angles[i] = T(int32_t(words[4 * i + 2] >> 1)) * T(1.0 / 2147483648.0);
+			}
+		}
+		const auto radiusView = BasicSignalView<T, TIME_DOMAIN>(radii.data(), numPairs);
+		Log(radiusView, radiusView);
+		radiusView *= T(-2);
+		Sqrt(radiusView, radiusView);
+		for (size_t i = 0; i < numPairs; ++i) {
+			output[2 * i] = radii[i] * CosCycles(angles[i]);
+			output[2 * i + 1] = radii[i] * SinCycles(angles[i]);
+		}
+	}
+
+	// Fills output with the samples from position on, generating whole blocks and keeping the needed part.
+	template <class T, class Transform>
+	void GenerateNoise(T* output, size_t size, uint64_t position, std::array<uint32_t, 2> key, Transform transform) {
+		constexpr size_t samplesPerBlock = noiseSamplesPerBlock<T>;
+		constexpr size_t chunkBlocks = 64;
+		std::array<uint32_t, 4 * chunkBlocks> words;
+		std::array<T, samplesPerBlock * chunkBlocks> samples;
+
+		uint64_t block = position / samplesPerBlock;
+		size_t skip = size_t(position % samplesPerBlock);
+		for (size_t written = 0; written < size;) {
+			const size_t numBlocks = std::min(chunkBlocks, (size - written + skip + samplesPerBlock - 1) / samplesPerBlock);
+			PhiloxBlocks(words.data(), block, numBlocks, key);
+			transform(samples.data(), words.data(), numBlocks);
+			const size_t count = std::min(numBlocks * samplesPerBlock - skip, size - written);
+			std::copy(samples.begin() + skip, samples.begin() + skip + count, output + written);
+			written += count;
+			block += numBlocks;
+			skip = 0;
+		}
+	}
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// White noise
+//------------------------------------------------------------------------------
+
+/// <summary> White noise with a uniform distribution in [<paramref name="low"/>, <paramref name="high"/>). </summary>
+/// <remarks> Sample n of the stream depends only on the seed and n, thanks to the counter-based Philox generator.
+///		Seeking is free, and filling with multiple threads gives the same samples as filling with one. </remarks>
+template <class T>
+class UniformNoise {
+	static_assert(std::is_floating_point_v<T>);
+
+public:
+	explicit UniformNoise(uint64_t seed, T low = T(-1), T high = T(1)) : m_key(impl::PhiloxKey(seed)), m_low(low), m_high(high) {
+		assert(low < high);
+	}
+
+	/// <summary> Fills <paramref name="output"/> with the next samples, split between <paramref name="numThreads"/> threads. </summary>
+	template <class SignalR, std::enable_if_t<is_mutable_signal_v<SignalR>, int> = 0>
+	void process(SignalR&& output, size_t numThreads = 1);
+	/// <summary> The next call to process starts at sample <paramref name="position"/> of the stream. </summary>
+	void seek(uint64_t position) { m_position = position; }
+	void reset() { seek(0); }
+
+	uint64_t position() const { return m_position; }
+
+private:
+	std::array<uint32_t, 2> m_key;
+	T m_low;
+	T m_high;
+	uint64_t m_position = 0;
+};
+
+
+template <class T>
+template <class SignalR, std::enable_if_t<is_mutable_signal_v<SignalR>, int>>
+void UniformNoise<T>::process(SignalR&& output, size_t numThreads) {
+	static_assert(std::is_same_v<typename signal_traits<std::decay_t<SignalR>>::type, T>);
+	T* data = output.data();
+	const T low = m_low;
+	const T range = m_high - m_low;
+	// Scaling a sample just below 1 may round up to high, which is excluded.
+	const T last = std::nextafter(m_high, m_low);
+	const auto transform = [low, range, last](T* samples, const uint32_t* words, size_t numBlocks) {
+		impl::UniformFromWords(samples, words, numBlocks);
+		for (size_t i = 0; i < numBlocks * impl::noiseSamplesPerBlock<T>; ++i) {
+			samples[i] = std::min(low + range * samples[i], last);
+		}
+	};
+	impl::ParallelFor(output.size(), numThreads, [&](size_t first, size_t last) {
+		impl::GenerateNoise(data + first, last - first, m_position + first, m_key, transform);
+	});
+	m_position += output.size();
+}
+
+
+/// <summary> White noise with a normal distribution. </summary>
+/// <remarks> Generated by the Box-Muller transform from the same counter-based stream as
+///		<see cref="UniformNoise"/>, so it can be seeked and filled in parallel the same way. </remarks>
+template <class T>
+class GaussianNoise {
+	static_assert(std::is_floating_point_v<T>);
+
+public:
+	explicit GaussianNoise(uint64_t seed, T mean = T(0), T stddev = T(1)) : m_key(impl::PhiloxKey(seed)), m_mean(mean), m_stddev(stddev) {}
+
+	/// <summary> Fills <paramref name="output"/> with the next samples, split between <paramref name="numThreads"/> threads. </summary>
+	template <class SignalR, std::enable_if_t<is_mutable_signal_v<SignalR>, int> = 0>
+	void process(SignalR&& output, size_t numThreads = 1);
+	/// <summary> The next call to process starts at sample <paramref name="position"/> of the stream. </summary>
+	void seek(uint64_t position) { m_position = position; }
+	void reset() { seek(0); }
+
+	uint64_t position() const { return m_position; }
+
+private:
+	std::array<uint32_t, 2> m_key;
+	T m_mean;
+	T m_stddev;
+	uint64_t m_position = 0;
+};
+
+
+template <class T>
+template <class SignalR, std::enable_if_t<is_mutable_signal_v<SignalR>, int>>
+void GaussianNoise<T>::process(SignalR&& output, size_t numThreads) {
+	static_assert(std::is_same_v<typename signal_traits<std::decay_t<SignalR>>::type, T>);
+	T* data = output.data();
+	const T mean = m_mean;
+	const T stddev = m_stddev;
+	const auto transform = [mean, stddev](T* samples, const uint32_t* words, size_t numBlocks) {
+		impl::GaussianFromWords(samples, words, numBlocks);
+		for (size_t i = 0; i < numBlocks * impl::noiseSamplesPerBlock<T>; ++i) {
+			samples[i] = mean + stddev * samples[i];
+		}
+	};
+	impl::ParallelFor(output.size(), numThreads, [&](size_t first, size_t last) {
+		impl::GenerateNoise(data + first, last - first, m_position + first, m_key, transform);
+	});
+	m_position += output.size();
+}
+
+
+//------------------------------------------------------------------------------
+// Colored noise
+//------------------------------------------------------------------------------
+
+/// <summary> Pink noise, whose power falls by 3 dB per octave, with unit variance. </summary>
+/// <remarks> Gaussian white noise is shaped by the 3 pole, 3 zero filter of J. O. Smith, which stays within
+///		0.3 dB of the ideal slope over 4 decades below the Nyquist frequency. The filter has state, so the
+///		stream has to be generated in order. </remarks>
+template <class T>
+class PinkNoise {
+	static_assert(std::is_floating_point_v<T>);
+
+public:
+	explicit PinkNoise(uint64_t seed, T stddev = T(1));
+
+	template <class SignalR, std::enable_if_t<is_mutable_signal_v<SignalR>, int> = 0>
+	void process(SignalR&& output);
+	void reset();
+
+private:
+	static constexpr std::array<double, 4> numerator = { 0.049922035, -0.095993537, 0.050612699, -0.004408786 };
+	static constexpr std::array<double, 4> denominator = { 1.0, -2.494956002, 2.017265875, -0.522189400 };
+
+	double filter(double input);
+
+	GaussianNoise<T> m_white;
+	double m_gain;
+	std::array<double, 3> m_state = { 0, 0, 0 };
+};
+
+
+template <class T>
+PinkNoise<T>::PinkNoise(uint64_t seed, T stddev) : m_white(seed) {
+	// The impulse response decays in a few thousand samples, its energy is the gain for white noise.
+	double energy = 0.0;
+	for (size_t n = 0; n < 100000; ++n) {
+		const double response = filter(n == 0 ? 1.0 : 0.0);
+		energy += response * response;
+	}
+	m_gain = double(stddev) / std::sqrt(energy);
+	reset();
+}
+
+template <class T>
+template <class SignalR, std::enable_if_t<is_mutable_signal_v<SignalR>, int>>
+void PinkNoise<T>::process(SignalR&& output) {
+	m_white.process(output);
+	for (auto& sample : output) {
+		sample = T(m_gain * filter(double(sample)));
+	}
+}
+
+template <class T>
+void PinkNoise<T>::reset() {
+	m_white.reset();
+	m_state = { 0, 0, 0 };
+}
+
+template <class T>
+double PinkNoise<T>::filter(double input) {
+	// Transposed direct form II.
+	const double output = numerator[0] * input + m_state[0];
+	m_state[0] = numerator[1] * input - denominator[1] * output + m_state[1];
+	m_state[1] = numerator[2] * input - denominator[2] * output + m_state[2];
+	m_state[2] = numerator[3] * input - denominator[3] * output;
+	return output;
+}
+
+
+/// <summary> Brown noise, whose power falls by 6 dB per octave, with unit variance. </summary>
+/// <remarks> Gaussian white noise is integrated by a leaky integrator. The leak keeps the output bounded, and
+///		flattens the spectrum below about (1 - <paramref name="decay"/>) / (2 pi) cycles per sample. </remarks>
+template <class T>
+class BrownNoise {
+	static_assert(std::is_floating_point_v<T>);
+
+public:
+	explicit BrownNoise(uint64_t seed, T stddev = T(1), double decay = 0.995)
+		: m_white(seed), m_decay(decay), m_gain(double(stddev) * std::sqrt(1.0 - decay * decay)) {
+		assert(0.0 <= decay && decay < 1.0);
+	}
+
+	template <class SignalR, std::enable_if_t<is_mutable_signal_v<SignalR>, int> = 0>
+	void process(SignalR&& output);
+	void reset();
+
+private:
+	GaussianNoise<T> m_white;
+	double m_decay;
+	double m_gain;
+	double m_state = 0.0;
+};
+
+
+template <class T>
+template <class SignalR, std::enable_if_t<is_mutable_signal_v<SignalR>, int>>
+void BrownNoise<T>::process(SignalR&& output) {
+	m_white.process(output);
+	for (auto& sample : output) {
+		m_state = m_decay * m_state + double(sample);
+		sample = T(m_gain * m_state);
+	}
+}
+
+template <class T>
+void BrownNoise<T>::reset() {
+	m_white.reset();
+	m_state = 0.0;
+}
+
+
+} // namespace dspbb
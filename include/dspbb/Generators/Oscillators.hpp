@@ -0,0 +1,289 @@
+#pragma once
+
+#include "../Primitives/Signal.hpp"
+#include "../Utility/Numbers.hpp"
+#include "../Utility/TypeTraits.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+
+namespace dspbb {
+
+
+namespace impl {
+
+	template <class T, size_t Count>
+	constexpr std::array<T, Count> SinTaylorCoefficients() {
+		std::array<T, Count> coefficients{};
+		double term = 1.0;
+		for (size_t k = 0; k < Count; ++k) {
+			coefficients[k] = T(term);
+			term /= -double((2 * k + 2) * (2 * k + 3));
+		}
+		return coefficients;
+	}
+
+	// sin(2 pi u) for u >= 0 in cycles. The argument is reduced to a quarter period by shifting it by half
+	// periods, each of which flips the sign, then a truncated Taylor series is accurate to the precision of T.
+	// Truncation stands in for floor, and there are no branches, so loops of it vectorize.
+	template <class T>
+	inline T SinCycles(T u) {
+		constexpr size_t numTerms = sizeof(T) <= 4 ? 6 : 11;
+		constexpr auto coefficients = SinTaylorCoefficients<T, numTerms>();
+
+		const T halfPeriods = T(int32_t(T(2) * u + T(0.5)));
+		const T parity = halfPeriods - T(2) * T(int32_t(halfPeriods / T(2)));
+		const T x = T(2) * pi_v<T> * (u - halfPeriods / T(2));
+		const T x2 = x * x;
+		T series = coefficients[numTerms - 1];
+		for (size_t k = numTerms - 1; k-- > 0;) {
+			series = series * x2 + coefficients[k];
+		}
+		return (T(1) - T(2) * parity) * x * series;
+	}
+
+	// cos(2 pi u) for u >= 0 in cycles.
+	template <class T>
+	inline T CosCycles(T u) {
+		return SinCycles(u + T(0.25));
+	}
+
+
+	// The difference between a step of height 2, smoothed by a two sample polynomial, and the naive step, for a
+	// step at phase zero. This is the step of a sawtooth from 1 to -1, so other step heights scale it by half
+	// their height. The phase and its increment are in cycles. The distances to the step are clamped to the
+	// width of the polynomials rather than branching, so loops of it vectorize.
+	template <class T>
+	inline T PolyBlep(T phase, T increment) {
+		const T width = std::max(std::abs(increment), std::numeric_limits<T>::min());
+		const T before = (width - std::min(phase, width)) / width;
+		const T after = (width + std::max(phase - T(1), -width)) / width;
+		return after * after - before * before;
+	}
+
+
+	// The phase of an oscillator, accumulated in double precision so that it does not drift.
+	struct PhaseAccumulator {
+		// Calls func(index, cycles, increment) for the next size samples, with the phase in cycles within [0, 1]
+		// and its increment in cycles per sample as type U. The phases are offset by whole cycles to be positive,
+		// and the chunks are short enough for the cycles to fit into 32 bit integers, whose conversions vectorize.
+		template <class U, class Func>
+		void Advance(size_t size, Func func) {
+			constexpr size_t chunkSize = 1024;
+			for (size_t first = 0; first < size; first += chunkSize) {
+				const size_t count = std::min(chunkSize, size - first);
+				const double halfSweep = sweep / 2.0;
+				const double reach = double(count) * (std::abs(step) + double(count) * std::abs(halfSweep));
+				const double offset = phase + std::ceil(reach) + 1.0;
+				for (int32_t i = 0; i < int32_t(count); ++i) {
+					const double n = double(i);
+					double cycles = offset + n * (step + n * halfSweep);
+					cycles -= double(int32_t(cycles));
+					func(first + size_t(i), U(cycles), U(step + n * sweep));
+				}
+
+				const double n = double(count);
+				phase += n * (step + n * halfSweep);
+				phase -= std::floor(phase);
+				step += n * sweep;
+			}
+		}
+
+		double phase = 0.0; // In cycles.
+		double step = 0.0; // In cycles per sample.
+		double sweep = 0.0; // In cycles per sample squared.
+	};
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// Wave shapes
+//------------------------------------------------------------------------------
+
+namespace waves {
+
+	/// <summary> The shapes take the phase in cycles, within [0, 1), and its increment per sample. </summary>
+	struct Sine {
+		template <class T>
+		T operator()(T phase, T) const { return impl::SinCycles(phase); }
+	};
+
+	/// <summary> Rises from -1 to 1 until <paramref name="tilt"/>, then falls back to -1, like <see cref="SawtoothWave"/>. </summary>
+	struct Sawtooth {
+		double tilt = 1.0;
+		template <class T>
+		T operator()(T phase, T) const {
+			const T rise = T(2) / std::max(T(tilt), std::numeric_limits<T>::min());
+			const T fall = T(2) / std::max(T(1.0 - tilt), std::numeric_limits<T>::min());
+			const T slope = phase > T(tilt) ? -fall : rise;
+			return T(1) + slope * (phase - T(tilt));
+		}
+	};
+
+	/// <summary> One until <paramref name="fill"/>, then zero, like <see cref="PwmWave"/>. </summary>
+	struct Pwm {
+		double fill = 0.5;
+		template <class T>
+		T operator()(T phase, T) const {
+			const T threshold = fill >= 1.0 ? T(2) : T(fill);
+			return phase < threshold ? T(1) : T(0);
+		}
+	};
+
+	/// <summary> One in the first half of the period, minus one in the second half. </summary>
+	struct Square {
+		template <class T>
+		T operator()(T phase, T) const { return phase < T(0.5) ? T(1) : T(-1); }
+	};
+
+	/// <summary> Rises from -1 to 1, with the jump smoothed by PolyBLEP to suppress aliasing. </summary>
+	struct BandlimitedSawtooth {
+		template <class T>
+		T operator()(T phase, T increment) const {
+			return T(2) * phase - T(1) - impl::PolyBlep(phase, increment);
+		}
+	};
+
+	/// <summary> Like <see cref="Pwm"/>, with both jumps smoothed by PolyBLEP to suppress aliasing. </summary>
+	struct BandlimitedPwm {
+		double fill = 0.5;
+		template <class T>
+		T operator()(T phase, T increment) const {
+			const T falling = phase + T(1.0 - fill);
+			const T shifted = falling - T(int32_t(falling));
+			const T naive = phase < T(fill) ? T(1) : T(0);
+			return naive + (impl::PolyBlep(phase, increment) - impl::PolyBlep(shifted, increment)) / T(2);
+		}
+	};
+
+	/// <summary> Like <see cref="Square"/>, with both jumps smoothed by PolyBLEP to suppress aliasing. </summary>
+	struct BandlimitedSquare {
+		template <class T>
+		T operator()(T phase, T increment) const {
+			return T(2) * BandlimitedPwm{ 0.5 }(phase, increment) - T(1);
+		}
+	};
+
+} // namespace waves
+
+
+//------------------------------------------------------------------------------
+// Oscillator
+//------------------------------------------------------------------------------
+
+/// <summary> Generates a waveform block by block, continuing the phase from one block to the next. </summary>
+/// <remarks> The phase is accumulated in double precision and only the wave shape is evaluated in T, so the phase
+///		does not drift no matter how long the oscillator runs. The frequency may be swept linearly to generate chirps.
+///		Complex outputs are only supported for sine waves, and give the analytic signal exp(j phase). </remarks>
+template <class T, class Shape = waves::Sine>
+class Oscillator {
+public:
+	/// <param name="frequency"> In Hz. </param>
+	/// <param name="phase"> The phase of the first sample in radians. </param>
+	Oscillator(uint64_t sampleRate, double frequency, double phase = 0, Shape shape = {});
+
+	/// <summary> Fills <paramref name="output"/> with the next samples. </summary>
+	template <class SignalR, std::enable_if_t<is_mutable_signal_v<SignalR>, int> = 0>
+	void process(SignalR&& output);
+	/// <summary> Restores the frequency and phase given at construction and stops the sweep. </summary>
+	void reset();
+
+	/// <summary> Changes the frequency from the next sample on, without a jump in phase. </summary>
+	void set_frequency(double frequency);
+	/// <summary> Changes the frequency linearly by <paramref name="rate"/> Hz per second. </summary>
+	void set_sweep(double rate);
+	/// <summary> Sets the phase of the next sample in radians. </summary>
+	void set_phase(double phase);
+
+	double frequency() const { return m_accumulator.step * double(m_sampleRate); }
+	double sweep() const { return m_accumulator.sweep * double(m_sampleRate) * double(m_sampleRate); }
+	double phase() const { return 2.0 * pi_v<double> * m_accumulator.phase; }
+
+private:
+	uint64_t m_sampleRate;
+	Shape m_shape;
+	double m_initialFrequency;
+	double m_initialPhase;
+	impl::PhaseAccumulator m_accumulator;
+};
+
+
+template <class T, class Shape>
+Oscillator<T, Shape>::Oscillator(uint64_t sampleRate, double frequency, double phase, Shape shape)
+	: m_sampleRate(sampleRate), m_shape(shape), m_initialFrequency(frequency), m_initialPhase(phase) {
+	assert(sampleRate > 0);
+	reset();
+}
+
+template <class T, class Shape>
+template <class SignalR, std::enable_if_t<is_mutable_signal_v<SignalR>, int>>
+void Oscillator<T, Shape>::process(SignalR&& output) {
+	using R = typename signal_traits<std::decay_t<SignalR>>::type;
+	using U = remove_complex_t<T>;
+	static_assert(!is_complex_v<T> || std::is_same_v<Shape, waves::Sine>, "Only sine waves can be complex.");
+
+	auto* data = output.data();
+	m_accumulator.template Advance<U>(output.size(), [this, data](size_t index, U cycles, U increment) {
+		if constexpr (is_complex_v<T>) {
+			data[index] = R(T(impl::CosCycles(cycles), impl::SinCycles(cycles)));
+		}
+		else {
+			data[index] = R(m_shape(cycles, increment));
+		}
+	});
+}
+
+template <class T, class Shape>
+void Oscillator<T, Shape>::reset() {
+	set_frequency(m_initialFrequency);
+	set_phase(m_initialPhase);
+	m_accumulator.sweep = 0.0;
+}
+
+template <class T, class Shape>
+void Oscillator<T, Shape>::set_frequency(double frequency) {
+	m_accumulator.step = frequency / double(m_sampleRate);
+}
+
+template <class T, class Shape>
+void Oscillator<T, Shape>::set_sweep(double rate) {
+	m_accumulator.sweep = rate / (double(m_sampleRate) * double(m_sampleRate));
+}
+
+template <class T, class Shape>
+void Oscillator<T, Shape>::set_phase(double phase) {
+	m_accumulator.phase = phase / (2.0 * pi_v<double>);
+	m_accumulator.phase -= std::floor(m_accumulator.phase);
+}
+
+
+template <class T>
+using SineOscillator = Oscillator<T, waves::Sine>;
+
+template <class T>
+using SawtoothOscillator = Oscillator<T, waves::Sawtooth>;
+
+template <class T>
+using PwmOscillator = Oscillator<T, waves::Pwm>;
+
+template <class T>
+using SquareOscillator = Oscillator<T, waves::Square>;
+
+template <class T>
+using BandlimitedSawtoothOscillator = Oscillator<T, waves::BandlimitedSawtooth>;
+
+template <class T>
+using BandlimitedPwmOscillator = Oscillator<T, waves::BandlimitedPwm>;
+
+template <class T>
+using BandlimitedSquareOscillator = Oscillator<T, waves::BandlimitedSquare>;
+
+
+} // namespace dspbb
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "../Primitives/SignalTraits.hpp"
+#include "Statistics.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+
+namespace dspbb {
+
+//------------------------------------------------------------------------------
+// Mean
+//------------------------------------------------------------------------------
+
+/// <summary> The mean of a stream that is fed block by block. </summary>
+/// <remarks> Accumulators of different parts of a stream, for example of the shards processed by separate threads,
+///		can be merged to get the result of the whole stream. Each block is reduced by the vectorized batch
+///		functions, then combined with the running result. </remarks>
+template <class T>
+class MeanAccumulator {
+	static_assert(std::is_floating_point_v<remove_complex_t<T>>);
+
+public:
+	template <class SignalT, std::enable_if_t<is_signal_like_v<std::decay_t<SignalT>>, int> = 0>
+	void add(const SignalT& block);
+	void merge(const MeanAccumulator& other);
+	void reset() { *this = {}; }
+
+	size_t count() const { return m_count; }
+	T mean() const { return m_mean; }
+
+private:
+	size_t m_count = 0;
+	T m_mean = T(0);
+};
+
+
+template <class T>
+template <class SignalT, std::enable_if_t<is_signal_like_v<std::decay_t<SignalT>>, int>>
+void MeanAccumulator<T>::add(const SignalT& block) {
+	if (block.empty()) {
+		return;
+	}
+	MeanAccumulator other;
+	other.m_count = block.size();
+	other.m_mean = T(Mean(block));
+	merge(other);
+}
+
+template <class T>
+void MeanAccumulator<T>::merge(const MeanAccumulator& other) {
+	using U = remove_complex_t<T>;
+	if (other.m_count == 0) {
+		return;
+	}
+	const size_t count = m_count + other.m_count;
+	m_mean += (other.m_mean - m_mean) * (U(other.m_count) / U(count));
+	m_count = count;
+}
+
+
+//------------------------------------------------------------------------------
+// Variance
+//------------------------------------------------------------------------------
+
+/// <summary> The mean and variance of a stream that is fed block by block, see <see cref="MeanAccumulator"/>. </summary>
+/// <remarks> The sums of squared deviations of blocks are merged by the formula of Chan, Golub and LeVeque,
+///		which is as accurate as the two-pass batch <see cref="Variance"/> function. </remarks>
+template <class T>
+class VarianceAccumulator {
+	static_assert(std::is_floating_point_v<T>);
+
+public:
+	template <class SignalT, std::enable_if_t<is_signal_like_v<std::decay_t<SignalT>>, int> = 0>
+	void add(const SignalT& block);
+	void merge(const VarianceAccumulator& other);
+	void reset() { *this = {}; }
+
+	size_t count() const { return m_count; }
+	T mean() const { return m_mean; }
+	T variance() const { return m_count > 0 ? m_sumDeviation / T(m_count) : T(0); }
+	T corrected_variance() const {
+		assert(m_count >= 2);
+		return m_sumDeviation / T(m_count - 1);
+	}
+	T standard_deviation() const { return std::sqrt(variance()); }
+	T corrected_standard_deviation() const { return std::sqrt(corrected_variance()); }
+
+private:
+	size_t m_count = 0;
+	T m_mean = T(0);
+	T m_sumDeviation = T(0);
+};
+
+
+template <class T>
+template <class SignalT, std::enable_if_t<is_signal_like_v<std::decay_t<SignalT>>, int>>
+void VarianceAccumulator<T>::add(const SignalT& block) {
+	if (block.empty()) {
+		return;
+	}
+	VarianceAccumulator other;
+	other.m_count = block.size();
+	other.m_mean = T(Mean(block));
+	other.m_sumDeviation = T(CentralMoment(block, 2, other.m_mean)) * T(block.size());
+	merge(other);
+}
+
+template <class T>
+void VarianceAccumulator<T>::merge(const VarianceAccumulator& other) {
+	if (other.m_count == 0) {
+		return;
+	}
+	if (m_count == 0) {
+		*this = other;
+		return;
+	}
+	const size_t count = m_count + other.m_count;
+	const T delta = other.m_mean - m_mean;
+	const T weight = T(other.m_count) / T(count);
+	m_sumDeviation += other.m_sumDeviation + delta * delta * T(m_count) * weight;
+	m_mean += delta * weight;
+	m_count = count;
+}
+
+
+//------------------------------------------------------------------------------
+// Covariance & correlation
+//------------------------------------------------------------------------------
+
+/// <summary> The covariance and correlation of two streams that are fed block by block, see <see cref="VarianceAccumulator"/>. </summary>
+template <class T>
+class CovarianceAccumulator {
+	static_assert(std::is_floating_point_v<T>);
+
+public:
+	/// <summary> Adds the pairs of samples of <paramref name="a"/> and <paramref name="b"/>, which have the same size. </summary>
+	template <class SignalT, class SignalU, std::enable_if_t<is_signal_like_v<std::decay_t<SignalT>> && is_signal_like_v<std::decay_t<SignalU>>, int> = 0>
+	void add(const SignalT& a, const SignalU& b);
+	void merge(const CovarianceAccumulator& other);
+	void reset() { *this = {}; }
+
+	size_t count() const { return m_a.count(); }
+	const VarianceAccumulator<T>& first() const { return m_a; }
+	const VarianceAccumulator<T>& second() const { return m_b; }
+	T covariance() const { return count() > 0 ? m_sumProduct / T(count()) : T(0); }
+	T corrected_covariance() const {
+		assert(count() >= 2);
+		return m_sumProduct / T(count() - 1);
+	}
+	T correlation() const { return covariance() / (m_a.standard_deviation() * m_b.standard_deviation()); }
+
+private:
+	VarianceAccumulator<T> m_a;
+	VarianceAccumulator<T> m_b;
+	T m_sumProduct = T(0);
+};
+
+
+template <class T>
+template <class SignalT, class SignalU, std::enable_if_t<is_signal_like_v<std::decay_t<SignalT>> && is_signal_like_v<std::decay_t<SignalU>>, int>>
+void CovarianceAccumulator<T>::add(const SignalT& a, const SignalU& b) {
+	assert(a.size() == b.size());
+	if (a.empty()) {
+		return;
+	}
+	CovarianceAccumulator other;
+	other.m_a.add(a);
+	other.m_b.add(b);
+	other.m_sumProduct = T(Covariance(a, b, other.m_a.mean(), other.m_b.mean())) * T(a.size());
+	merge(other);
+}
+
+template <class T>
+void CovarianceAccumulator<T>::merge(const CovarianceAccumulator& other) {
+	if (other.count() == 0) {
+		return;
+	}
+	if (count() == 0) {
+		*this = other;
+		return;
+	}
+	const T deltaA = other.m_a.mean() - m_a.mean();
+	const T deltaB = other.m_b.mean() - m_b.mean();
+	const T weight = T(other.count()) / T(count() + other.count());
+	m_sumProduct += other.m_sumProduct + deltaA * deltaB * T(count()) * weight;
+	m_a.merge(other.m_a);
+	m_b.merge(other.m_b);
+}
+
+} // namespace dspbb
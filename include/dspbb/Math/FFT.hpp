@@ -190,6 +190,22 @@ constexpr size_t FourierFrequency2Bin(double frequency, size_t numBins, uint64_t
 	return size_t(frequency / double(sampleRate) * double(numBins) + 0.5f);
 }
 
+/// <summary> The smallest length not less than <paramref name="size"/> that only has the prime factors 2, 3, 5 and 7,
+///		for which the FFT is the fastest. </summary>
+constexpr size_t FftFastLength(size_t size) {
+	for (size_t candidate = std::max(size, size_t(1));; ++candidate) {
+		size_t remainder = candidate;
+		for (size_t factor : { 2, 3, 5, 7 }) {
+			while (remainder % factor == 0) {
+				remainder /= factor;
+			}
+		}
+		if (remainder == 1) {
+			return candidate;
+		}
+	}
+}
+
 namespace impl {
 	template <class SignalR, class SignalT, std::enable_if_t<is_same_domain_v<SignalR, SignalT>, int> = 0>
 	void BasicShift(SignalR&& out, const SignalT& in, size_t shift) {
@@ -0,0 +1,523 @@
+#pragma once
+
+#include "../Filtering/StreamHistory.hpp"
+#include "../Primitives/Signal.hpp"
+#include "../Primitives/SignalTraits.hpp"
+#include "../Primitives/SignalView.hpp"
+#include "../Utility/TypeTraits.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace dspbb {
+
+
+namespace impl {
+
+	// A running sum with Kahan compensation, so that the rounding error stays bounded instead of growing
+	// when samples are added and removed for a long time.
+	template <class T>
+	struct CompensatedSum {
+		void add(T value) {
+			const T corrected = value - compensation;
+			const T updated = sum + corrected;
+			compensation = (updated - sum) - corrected;
+			sum = updated;
+		}
+		T value() const { return sum; }
+
+		T sum = T(0);
+		T compensation = T(0);
+	};
+
+
+	// The sliding window over a stream. The first windows are completed by zeros before the stream.
+	template <class T>
+	class SlidingWindow {
+	public:
+		explicit SlidingWindow(size_t windowSize) : m_windowSize(windowSize), m_history(windowSize) { assert(windowSize > 0); }
+
+		// Calls func(index, entering, leaving) for every sample of input, leaving being the sample that drops out of
+		// the window as entering is added.
+		template <class SignalT, class Func>
+		void process(const SignalT& input, Func func) {
+			const int64_t first = m_history.size();
+			m_history.append(input);
+			const auto samples = m_history.window(first + int64_t(input.size()) - 1, input.size() + m_windowSize);
+			for (size_t n = 0; n < input.size(); ++n) {
+				func(n, samples[n + m_windowSize], samples[n]);
+			}
+			m_history.release(m_history.size() - int64_t(m_windowSize));
+		}
+
+		void reset() { m_history.reset(); }
+		size_t window_size() const { return m_windowSize; }
+
+	private:
+		size_t m_windowSize;
+		StreamHistory<T> m_history;
+	};
+
+
+	// Keeps the candidates for the extremum of the window in a ring buffer, ordered by index and by value. A new
+	// sample removes all candidates it beats, and the front candidate leaves when it falls out of the window.
+	template <class T, class Compare>
+	class MovingExtremum {
+	public:
+		explicit MovingExtremum(size_t windowSize) : m_windowSize(windowSize), m_indices(windowSize + 1), m_values(windowSize + 1) {
+			assert(windowSize > 0);
+			reset();
+		}
+
+		template <class SignalR, class SignalT>
+		void process(SignalR& output, const SignalT& input) {
+			assert(output.size() == input.size());
+			const size_t capacity = m_values.size();
+			for (size_t n = 0; n < input.size(); ++n) {
+				const T value = input[n];
+				const int64_t index = m_position + int64_t(n);
+				while (m_count > 0 && !Compare{}(m_values[(m_front + m_count - 1) % capacity], value)) {
+					--m_count;
+				}
+				const size_t back = (m_front + m_count) % capacity;
+				m_indices[back] = index;
+				m_values[back] = value;
+				++m_count;
+				if (m_indices[m_front] <= index - int64_t(m_windowSize)) {
+					m_front = (m_front + 1) % capacity;
+					--m_count;
+				}
+				output[n] = m_values[m_front];
+			}
+			m_position += int64_t(input.size());
+		}
+
+		void reset() {
+			// The zeros before the stream are represented by the last of them.
+			m_indices[0] = -1;
+			m_values[0] = T(0);
+			m_front = 0;
+			m_count = 1;
+			m_position = 0;
+		}
+
+		size_t window_size() const { return m_windowSize; }
+
+	private:
+		size_t m_windowSize;
+		std::vector<int64_t> m_indices;
+		std::vector<T> m_values;
+		size_t m_front = 0;
+		size_t m_count = 0;
+		int64_t m_position = 0;
+	};
+
+	// Selects an order statistic of a sliding window with two heaps, the lower one holding the rank + 1 smallest
+	// samples with the largest on top, and the upper one the rest with the smallest on top. The entering sample
+	// takes the place of the leaving one in the same heap, so each sample costs O(log W). After Ekstrom's
+	// "mediator" median filter.
+	template <class T>
+	class MovingOrderStatistic {
+	public:
+		MovingOrderStatistic(size_t windowSize, size_t rank)
+			: m_values(windowSize), m_heaps{ std::vector<size_t>(rank + 1), std::vector<size_t>(windowSize - rank - 1) }, m_heapOf(windowSize), m_positionOf(windowSize) {
+			assert(rank < windowSize);
+			reset();
+		}
+
+		// Replaces the oldest sample by value and returns the order statistic of the window.
+		T push(T value) {
+			const size_t slot = m_next;
+			m_next = m_next + 1 < m_values.size() ? m_next + 1 : 0;
+			m_values[slot] = value;
+			const size_t heap = m_heapOf[slot];
+			sift_down(heap, sift_up(heap, m_positionOf[slot]));
+
+			auto& lower = m_heaps[0];
+			auto& upper = m_heaps[1];
+			if (!upper.empty() && m_values[upper[0]] < m_values[lower[0]]) {
+				std::swap(lower[0], upper[0]);
+				m_heapOf[lower[0]] = 0;
+				m_heapOf[upper[0]] = 1;
+				sift_down(0, 0);
+				sift_down(1, 0);
+			}
+			return m_values[lower[0]];
+		}
+
+		void reset() {
+			std::fill(m_values.begin(), m_values.end(), T(0));
+			const size_t lowerSize = m_heaps[0].size();
+			for (size_t slot = 0; slot < m_values.size(); ++slot) {
+				const size_t heap = slot < lowerSize ? 0 : 1;
+				const size_t position = slot < lowerSize ? slot : slot - lowerSize;
+				m_heaps[heap][position] = slot;
+				m_heapOf[slot] = heap;
+				m_positionOf[slot] = position;
+			}
+			m_next = 0;
+		}
+
+	private:
+		bool above(size_t heap, size_t slot, size_t other) const {
+			return heap == 0 ? m_values[other] < m_values[slot] : m_values[slot] < m_values[other];
+		}
+
+		void exchange(size_t heap, size_t position, size_t other) {
+			auto& entries = m_heaps[heap];
+			std::swap(entries[position], entries[other]);
+			m_positionOf[entries[position]] = position;
+			m_positionOf[entries[other]] = other;
+		}
+
+		size_t sift_up(size_t heap, size_t position) {
+			const auto& entries = m_heaps[heap];
+			while (position > 0) {
+				const size_t parent = (position - 1) / 2;
+				if (!above(heap, entries[position], entries[parent])) {
+					break;
+				}
+				exchange(heap, position, parent);
+				position = parent;
+			}
+			return position;
+		}
+
+		void sift_down(size_t heap, size_t position) {
+			const auto& entries = m_heaps[heap];
+			for (size_t child = 2 * position + 1; child < entries.size(); child = 2 * position + 1) {
+				if (child + 1 < entries.size() && above(heap, entries[child + 1], entries[child])) {
+					++child;
+				}
+				if (!above(heap, entries[child], entries[position])) {
+					break;
+				}
+				exchange(heap, position, child);
+				position = child;
+			}
+		}
+
+		std::vector<T> m_values;
+		std::array<std::vector<size_t>, 2> m_heaps;
+		std::vector<size_t> m_heapOf;
+		std::vector<size_t> m_positionOf;
+		size_t m_next = 0;
+	};
+
+
+	// The compare-exchanges of Batcher's odd-even merge sort of size elements, with those that cannot affect the
+	// element at rank removed.
+	inline std::vector<std::pair<size_t, size_t>> SelectionNetwork(size_t size, size_t rank) {
+		std::vector<std::pair<size_t, size_t>> network;
+		for (size_t p = 1; p < size; p *= 2) {
+			for (size_t k = p; k >= 1; k /= 2) {
+				for (size_t j = k % p; j + k < size; j += 2 * k) {
+					for (size_t i = 0; i < std::min(k, size - j - k); ++i) {
+						if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+							network.emplace_back(i + j, i + j + k);
+						}
+					}
+				}
+			}
+		}
+
+		std::vector<bool> needed(size, false);
+		needed[rank] = true;
+		std::vector<std::pair<size_t, size_t>> pruned;
+		for (auto it = network.rbegin(); it != network.rend(); ++it) {
+			if (needed[it->first] || needed[it->second]) {
+				needed[it->first] = needed[it->second] = true;
+				pruned.push_back(*it);
+			}
+		}
+		std::reverse(pruned.begin(), pruned.end());
+		return pruned;
+	}
+
+} // namespace impl
+
+
+//------------------------------------------------------------------------------
+// Sum & mean
+//------------------------------------------------------------------------------
+
+/// <summary> The sum of the last <paramref name="windowSize"/> samples of a stream, including the current one. </summary>
+/// <remarks> The window slides by adding the entering and subtracting the leaving sample, so each output costs
+///		O(1) regardless of the window size. Both go into the compensated sum separately, so that the rounding
+///		error stays bounded on long streams instead of growing with their length. The stream is preceded by
+///		zeros to fill the first windows. The output may be the same signal as the input. </remarks>
+template <class T>
+class MovingSum {
+public:
+	explicit MovingSum(size_t windowSize) : m_window(windowSize) {}
+
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	void process(SignalR&& output, const SignalT& input) {
+		assert(output.size() == input.size());
+		m_window.process(input, [this, &output](size_t n, T entering, T leaving) {
+			m_sum.add(entering);
+			m_sum.add(-leaving);
+			output[n] = m_sum.value();
+		});
+	}
+	void reset() {
+		m_window.reset();
+		m_sum = {};
+	}
+
+	size_t window_size() const { return m_window.window_size(); }
+
+private:
+	impl::SlidingWindow<T> m_window;
+	impl::CompensatedSum<T> m_sum;
+};
+
+
+/// <summary> The mean of the last <paramref name="windowSize"/> samples of a stream, see <see cref="MovingSum"/>. </summary>
+template <class T>
+class MovingMean {
+	static_assert(std::is_floating_point_v<remove_complex_t<T>>);
+
+public:
+	explicit MovingMean(size_t windowSize) : m_sum(windowSize) {}
+
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	void process(SignalR&& output, const SignalT& input) {
+		m_sum.process(output, input);
+		output *= remove_complex_t<T>(1) / remove_complex_t<T>(window_size());
+	}
+	void reset() { m_sum.reset(); }
+
+	size_t window_size() const { return m_sum.window_size(); }
+
+private:
+	MovingSum<T> m_sum;
+};
+
+
+//------------------------------------------------------------------------------
+// RMS & variance
+//------------------------------------------------------------------------------
+
+/// <summary> The root mean square of the last <paramref name="windowSize"/> samples of a stream. </summary>
+/// <remarks> Slides a compensated sum of squares like <see cref="MovingSum"/>. </remarks>
+template <class T>
+class MovingRootMeanSquare {
+	static_assert(std::is_floating_point_v<T>);
+
+public:
+	explicit MovingRootMeanSquare(size_t windowSize) : m_window(windowSize) {}
+
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	void process(SignalR&& output, const SignalT& input) {
+		assert(output.size() == input.size());
+		const T scale = T(1) / T(window_size());
+		m_window.process(input, [this, &output, scale](size_t n, T entering, T leaving) {
+			m_sumSquare.add(entering * entering);
+			m_sumSquare.add(-leaving * leaving);
+			output[n] = std::sqrt(std::max(T(0), m_sumSquare.value() * scale));
+		});
+	}
+	void reset() {
+		m_window.reset();
+		m_sumSquare = {};
+	}
+
+	size_t window_size() const { return m_window.window_size(); }
+
+private:
+	impl::SlidingWindow<T> m_window;
+	impl::CompensatedSum<T> m_sumSquare;
+};
+
+
+/// <summary> The population variance of the last <paramref name="windowSize"/> samples of a stream. </summary>
+/// <remarks> The mean and the sum of squared deviations are updated with Welford's method adapted to a sliding
+///		window, which, unlike the difference of the mean square and the squared mean, stays accurate when the
+///		mean is large compared to the deviations. </remarks>
+template <class T>
+class MovingVariance {
+	static_assert(std::is_floating_point_v<T>);
+
+public:
+	explicit MovingVariance(size_t windowSize) : m_window(windowSize) {}
+
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	void process(SignalR&& output, const SignalT& input) {
+		assert(output.size() == input.size());
+		const T scale = T(1) / T(window_size());
+		m_window.process(input, [this, &output, scale](size_t n, T entering, T leaving) {
+			const T oldMean = m_sum.value() * scale;
+			m_sum.add(entering);
+			m_sum.add(-leaving);
+			const T newMean = m_sum.value() * scale;
+			m_sumDeviation.add((entering - leaving) * (entering - newMean + leaving - oldMean));
+			output[n] = std::max(T(0), m_sumDeviation.value() * scale);
+		});
+	}
+	void reset() {
+		m_window.reset();
+		m_sum = {};
+		m_sumDeviation = {};
+	}
+
+	size_t window_size() const { return m_window.window_size(); }
+
+private:
+	impl::SlidingWindow<T> m_window;
+	impl::CompensatedSum<T> m_sum;
+	impl::CompensatedSum<T> m_sumDeviation;
+};
+
+
+//------------------------------------------------------------------------------
+// Min & max
+//------------------------------------------------------------------------------
+
+/// <summary> The largest of the last <paramref name="windowSize"/> samples of a stream. </summary>
+/// <remarks> Uses a monotonic queue, so each output costs amortized O(1) regardless of the window size. </remarks>
+template <class T>
+class MovingMax {
+public:
+	explicit MovingMax(size_t windowSize) : m_extremum(windowSize) {}
+
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	void process(SignalR&& output, const SignalT& input) { m_extremum.process(output, input); }
+	void reset() { m_extremum.reset(); }
+
+	size_t window_size() const { return m_extremum.window_size(); }
+
+private:
+	impl::MovingExtremum<T, std::greater<T>> m_extremum;
+};
+
+
+/// <summary> The smallest of the last <paramref name="windowSize"/> samples of a stream, see <see cref="MovingMax"/>. </summary>
+template <class T>
+class MovingMin {
+public:
+	explicit MovingMin(size_t windowSize) : m_extremum(windowSize) {}
+
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	void process(SignalR&& output, const SignalT& input) { m_extremum.process(output, input); }
+	void reset() { m_extremum.reset(); }
+
+	size_t window_size() const { return m_extremum.window_size(); }
+
+private:
+	impl::MovingExtremum<T, std::less<T>> m_extremum;
+};
+
+
+//------------------------------------------------------------------------------
+// Median & percentile
+//------------------------------------------------------------------------------
+
+/// <summary> A percentile of the last <paramref name="windowSize"/> samples of a stream, for rank-order filtering. </summary>
+/// <remarks> The output is the sample of rank round(percentile * (windowSize - 1)) in the sorted window.
+///		Windows of up to 15 samples are sorted by a sorting network run on many windows at once, which vectorizes.
+///		Longer windows are kept in two heaps at O(log windowSize) per sample. The stream is preceded by zeros
+///		to fill the first windows, and the output may be the same signal as the input. </remarks>
+template <class T>
+class MovingPercentile {
+	static_assert(std::is_arithmetic_v<T>);
+
+public:
+	/// <param name="percentile"> Between 0 for the minimum and 1 for the maximum. </param>
+	MovingPercentile(size_t windowSize, double percentile);
+
+	template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int> = 0>
+	void process(SignalR&& output, const SignalT& input);
+	void reset();
+
+	size_t window_size() const { return m_windowSize; }
+	/// <summary> The index of the output in the sorted window. </summary>
+	size_t rank() const { return m_rank; }
+
+private:
+	static constexpr size_t maxNetworkSize = 15;
+	static constexpr size_t chunkSize = 64;
+
+	size_t m_windowSize;
+	size_t m_rank;
+	impl::StreamHistory<T> m_history;
+	std::vector<std::pair<size_t, size_t>> m_network;
+	std::vector<T> m_columns;
+	impl::MovingOrderStatistic<T> m_heaps;
+};
+
+
+template <class T>
+MovingPercentile<T>::MovingPercentile(size_t windowSize, double percentile)
+	: m_windowSize(windowSize),
+	  m_rank(size_t(std::round(std::clamp(percentile, 0.0, 1.0) * double(windowSize - 1)))),
+	  m_history(windowSize <= maxNetworkSize ? windowSize - 1 : 0),
+	  m_heaps(windowSize <= maxNetworkSize ? 1 : windowSize, windowSize <= maxNetworkSize ? 0 : m_rank) {
+	assert(windowSize > 0);
+	if (windowSize <= maxNetworkSize) {
+		m_network = impl::SelectionNetwork(windowSize, m_rank);
+		m_columns.resize(windowSize * chunkSize);
+	}
+}
+
+template <class T>
+template <class SignalR, class SignalT, std::enable_if_t<is_mutable_signal_v<SignalR> && is_same_domain_v<SignalR, SignalT>, int>>
+void MovingPercentile<T>::process(SignalR&& output, const SignalT& input) {
+	assert(output.size() == input.size());
+	if (m_windowSize > maxNetworkSize) {
+		for (size_t n = 0; n < input.size(); ++n) {
+			output[n] = m_heaps.push(input[n]);
+		}
+		return;
+	}
+
+	// Column j holds sample j of consecutive windows, so every compare-exchange works on a whole chunk of windows.
+	const int64_t first = m_history.size();
+	m_history.append(input);
+	const auto samples = m_history.window(first + int64_t(input.size()) - 1, input.size() + m_windowSize - 1);
+	for (size_t chunk = 0; chunk < input.size(); chunk += chunkSize) {
+		const size_t count = std::min(chunkSize, input.size() - chunk);
+		for (size_t j = 0; j < m_windowSize; ++j) {
+			std::copy_n(samples.begin() + chunk + j, count, m_columns.begin() + j * chunkSize);
+		}
+		for (const auto& [a, b] : m_network) {
+			T* lower = m_columns.data() + a * chunkSize;
+			T* upper = m_columns.data() + b * chunkSize;
+			for (size_t i = 0; i < count; ++i) {
+				const T x = lower[i];
+				const T y = upper[i];
+				lower[i] = y < x ? y : x;
+				upper[i] = y < x ? x : y;
+			}
+		}
+		const auto selected = m_columns.begin() + m_rank * chunkSize;
+		std::copy(selected, selected + count, output.begin() + chunk);
+	}
+	m_history.release(m_history.size() - int64_t(m_windowSize - 1));
+}
+
+template <class T>
+void MovingPercentile<T>::reset() {
+	m_history.reset();
+	m_heaps.reset();
+}
+
+
+/// <summary> The median of the last <paramref name="windowSize"/> samples of a stream, see <see cref="MovingPercentile"/>. </summary>
+/// <remarks> For even window sizes, the upper of the two middle samples. </remarks>
+template <class T>
+class MovingMedian : public MovingPercentile<T> {
+public:
+	explicit MovingMedian(size_t windowSize) : MovingPercentile<T>(windowSize, 0.5) {}
+};
+
+
+} // namespace dspbb
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#include <xmmintrin.h>
+	#define DSPBB_DENORMALS_SSE
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+	#define DSPBB_DENORMALS_AARCH64
+#endif
+
+
+namespace dspbb {
+
+enum class eDenormalHandling {
+	FLUSH_TO_ZERO,
+	DC_OFFSET,
+	KEEP,
+};
+
+
+/// <summary> Enables flush-to-zero and denormals-are-zero for the current thread while in scope. </summary>
+/// <remarks> No-op on platforms where the floating point control register is not accessible. </remarks>
+class ScopedFlushDenormals {
+public:
+	ScopedFlushDenormals();
+	ScopedFlushDenormals(const ScopedFlushDenormals&) = delete;
+	ScopedFlushDenormals& operator=(const ScopedFlushDenormals&) = delete;
+	~ScopedFlushDenormals();
+
+private:
+	uint64_t m_previous = 0;
+};
+
+
+inline ScopedFlushDenormals::ScopedFlushDenormals() {
+#if defined(DSPBB_DENORMALS_SSE)
+	constexpr unsigned flushToZero = 0x8000;
+	constexpr unsigned denormalsAreZero = 0x0040;
+	m_previous = _mm_getcsr();
+	_mm_setcsr(static_cast<unsigned>(m_previous) | flushToZero | denormalsAreZero);
+#elif defined(DSPBB_DENORMALS_AARCH64)
+	constexpr uint64_t flushToZero = uint64_t(1) << 24;
+	uint64_t fpcr;
+	__asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+	m_previous = fpcr;
+	fpcr |= flushToZero;
+	__asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
+#endif
+}
+
+inline ScopedFlushDenormals::~ScopedFlushDenormals() {
+#if defined(DSPBB_DENORMALS_SSE)
+	_mm_setcsr(static_cast<unsigned>(m_previous));
+#elif defined(DSPBB_DENORMALS_AARCH64)
+	__asm__ __volatile__("msr fpcr, %0" : : "r"(m_previous));
+#endif
+}
+
+
+/// <summary> A tiny constant that keeps recursive filter states above the subnormal range when added to the input. </summary>
+template <class T>
+T DenormalOffset() {
+	static_assert(std::is_floating_point_v<T>);
+	return std::sqrt(std::numeric_limits<T>::min());
+}
+
+} // namespace dspbb
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+
+namespace dspbb {
+
+namespace impl {
+
+	/// <summary> Splits [0, size) into at most <paramref name="numThreads"/> contiguous ranges and calls
+	///		func(first, last) for each on its own thread. The calling thread takes the first range. </summary>
+	template <class Func>
+	void ParallelFor(size_t size, size_t numThreads, Func func) {
+		numThreads = std::max(size_t(1), std::min(numThreads, size));
+		const size_t chunkSize = (size + numThreads - 1) / numThreads;
+		std::vector<std::thread> threads;
+		threads.reserve(numThreads - 1);
+		for (size_t first = chunkSize; first < size; first += chunkSize) {
+			threads.emplace_back(func, first, std::min(size, first + chunkSize));
+		}
+		func(size_t(0), std::min(size, chunkSize));
+		for (auto& thread : threads) {
+			thread.join();
+		}
+	}
+
+} // namespace impl
+
+} // namespace dspbb
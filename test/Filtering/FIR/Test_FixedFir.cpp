@@ -0,0 +1,50 @@
+#include "../../TestUtils.hpp"
+
+#include <dspbb/Filtering/FIR.hpp>
+#include <dspbb/Math/Functions.hpp>
+#include <dspbb/Math/Statistics.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+TEST_CASE("Fixed FIR matches convolution", "[FixedFir]") {
+	const auto filter = DesignFilter<double, TIME_DOMAIN>(7, Fir.Lowpass.Windowed.Cutoff(0.3));
+	FixedFir<double, 7> fixed{ filter };
+
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(300);
+	const auto expected = Convolution(signal, filter, CONV_FULL);
+	Signal<double> result(signal.size());
+	fixed.feed(signal.begin(), signal.end(), result.begin());
+
+	REQUIRE(Max(Abs(result - AsConstView(expected).subsignal(0, signal.size()))) < 1e-12);
+}
+
+TEST_CASE("Fixed FIR constexpr", "[FixedFir]") {
+	constexpr auto response = [] {
+		FixedFir<int, 3> filter{ { 1, 2, 3 } };
+		std::array<int, 5> output = {};
+		output[0] = filter.feed(1);
+		output[1] = filter.feed(1);
+		output[2] = filter.feed(0);
+		output[3] = filter.feed(0);
+		output[4] = filter.feed(0);
+		return output;
+	}();
+	static_assert(response[0] == 1);
+	static_assert(response[1] == 3);
+	static_assert(response[2] == 5);
+	static_assert(response[3] == 3);
+	static_assert(response[4] == 0);
+	static_assert(FixedFir<float, 4>::size() == 4);
+}
+
+TEST_CASE("Fixed FIR single tap", "[FixedFir]") {
+	FixedFir<float, 1> fixed{ { 2.0f } };
+	REQUIRE(fixed.feed(3.0f) == 6.0f);
+	fixed.reset();
+	REQUIRE(fixed.feed(1.0f) == 2.0f);
+}
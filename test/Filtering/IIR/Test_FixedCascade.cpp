@@ -0,0 +1,65 @@
+#include "../../TestUtils.hpp"
+
+#include <dspbb/Filtering/IIR.hpp>
+#include <dspbb/Math/Functions.hpp>
+#include <dspbb/Math/Statistics.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+TEST_CASE("Fixed cascade matches cascaded form", "[FixedCascade]") {
+	const auto sys = CascadedBiquad(DesignFilter<double>(4, Iir.Lowpass.Chebyshev1.Cutoff(0.3).PassbandRipple(0.1)));
+	REQUIRE(sys.sections.size() == 2);
+	CascadedForm<double> state{ sys.order() };
+	FixedCascade<double, 2> fixed{ sys };
+
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(300);
+	const auto expected = Filter(signal, sys, state);
+	Signal<double> result(signal.size());
+	fixed.feed(signal.begin(), signal.end(), result.begin());
+
+	REQUIRE(Max(Abs(result - expected)) < 1e-9);
+}
+
+TEST_CASE("Fixed cascade odd order", "[FixedCascade]") {
+	const auto sys = CascadedBiquad(DesignFilter<double>(3, Iir.Highpass.Butterworth.Cutoff(0.4)));
+	CascadedForm<double> state{ sys.order() };
+	FixedCascade<double, 2> fixed{ sys };
+
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(300);
+	const auto expected = Filter(signal, sys, state);
+	Signal<double> result(signal.size());
+	fixed.feed(signal.begin(), signal.end(), result.begin());
+
+	REQUIRE(Max(Abs(result - expected)) < 1e-9);
+}
+
+TEST_CASE("Fixed cascade constexpr", "[FixedCascade]") {
+	constexpr auto impulseResponse = [] {
+		FixedCascade<double, 1> filter{ { FixedBiquad<double>{ { 0.0, 0.0, 1.0 }, { 0.0, -0.5 } } } };
+		std::array<double, 4> response = {};
+		response[0] = filter.feed(1.0);
+		for (size_t i = 1; i < response.size(); ++i) {
+			response[i] = filter.feed(0.0);
+		}
+		return response;
+	}();
+	static_assert(impulseResponse[0] == 1.0);
+	static_assert(impulseResponse[1] == 0.5);
+	static_assert(impulseResponse[2] == 0.25);
+	static_assert(impulseResponse[3] == 0.125);
+	static_assert(FixedCascade<float, 3>::order() == 6);
+}
+
+TEST_CASE("Fixed cascade reset", "[FixedCascade]") {
+	const auto sys = CascadedBiquad(DesignFilter<float>(2, Iir.Lowpass.Butterworth.Cutoff(0.3f)));
+	FixedCascade<float, 1> fixed{ sys };
+	const float first = fixed.feed(1.0f);
+	fixed.feed(1.0f);
+	fixed.reset();
+	REQUIRE(fixed.feed(1.0f) == first);
+}
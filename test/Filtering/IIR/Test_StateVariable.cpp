@@ -0,0 +1,89 @@
+#include "../../TestUtils.hpp"
+
+#include <dspbb/Filtering/IIR.hpp>
+#include <dspbb/Math/Functions.hpp>
+#include <dspbb/Math/Statistics.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+TEST_CASE("State variable lowpass matches Butterworth", "[StateVariable]") {
+	const auto reference = TransferFunction(DesignFilter<double>(2, Iir.Lowpass.Butterworth.Cutoff(0.3)));
+	DirectFormII<double> state{ 2 };
+	StateVariableFilter<double> svf{ StateVariableLowpass(0.3, 1.0 / std::sqrt(2.0)) };
+
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(200);
+	const auto expected = Filter(signal, reference, state);
+	Signal<double> result(signal.size());
+	svf.feed(signal.begin(), signal.end(), result.begin());
+
+	REQUIRE(Max(Abs(result - expected)) < 1e-9);
+}
+
+TEST_CASE("State variable responses", "[StateVariable]") {
+	const Signal<double> signal(2000, 1.0);
+	const auto dcGain = [&signal](const StateVariableCoefficients<double>& coefficients) {
+		StateVariableFilter<double> svf{ coefficients };
+		Signal<double> result(signal.size());
+		svf.feed(signal.begin(), signal.end(), result.begin());
+		return result[signal.size() - 1];
+	};
+	REQUIRE(dcGain(StateVariableLowpass(0.2, 0.7)) == Approx(1.0));
+	REQUIRE(dcGain(StateVariableHighpass(0.2, 0.7)) == Approx(0.0).margin(1e-9));
+	REQUIRE(dcGain(StateVariableBandpass(0.2, 0.7)) == Approx(0.0).margin(1e-9));
+	REQUIRE(dcGain(StateVariableNotch(0.2, 0.7)) == Approx(1.0));
+	REQUIRE(dcGain(StateVariableAllpass(0.2, 0.7)) == Approx(1.0));
+	REQUIRE(dcGain(StateVariableBell(0.2, 0.7, 2.0)) == Approx(1.0));
+	REQUIRE(dcGain(StateVariableLowShelf(0.2, 0.7, 2.0)) == Approx(2.0));
+	REQUIRE(dcGain(StateVariableHighShelf(0.2, 0.7, 2.0)) == Approx(1.0));
+}
+
+TEST_CASE("State variable ramp reaches target", "[StateVariable]") {
+	const auto start = StateVariableLowpass(0.1f, 0.7f);
+	const auto end = StateVariableHighpass(0.6f, 2.0f);
+	StateVariableFilter<float> svf{ start };
+	svf.target(end, 150);
+
+	const auto signal = RandomSignal<float, TIME_DOMAIN>(100);
+	Signal<float> result(signal.size());
+	svf.feed(signal.begin(), signal.end(), result.begin());
+	REQUIRE(svf.coefficients().g > start.g);
+	REQUIRE(svf.coefficients().g < end.g);
+
+	svf.feed(signal.begin(), signal.end(), result.begin());
+	REQUIRE(svf.coefficients().g == end.g);
+	REQUIRE(svf.coefficients().k == end.k);
+	REQUIRE(svf.coefficients().m2 == end.m2);
+}
+
+TEST_CASE("State variable block matches sample", "[StateVariable]") {
+	StateVariableFilter<double> block{ StateVariableLowpass(0.1, 0.7) };
+	StateVariableFilter<double> sample{ StateVariableLowpass(0.1, 0.7) };
+	block.target(StateVariableBell(0.4, 3.0, 4.0), 300);
+	sample.target(StateVariableBell(0.4, 3.0, 4.0), 300);
+
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(500);
+	Signal<double> expected(signal.size());
+	Signal<double> result(signal.size());
+	block.feed(signal.begin(), signal.end(), result.begin());
+	for (size_t i = 0; i < signal.size(); ++i) {
+		expected[i] = sample.feed(signal[i]);
+	}
+	REQUIRE(Max(Abs(result - expected)) < 1e-12);
+}
+
+TEST_CASE("State variable stable under modulation", "[StateVariable]") {
+	StateVariableFilter<float> svf{ StateVariableLowpass(0.5f, 10.0f) };
+	const auto signal = RandomSignal<float, TIME_DOMAIN>(64);
+	Signal<float> result(signal.size());
+	for (int i = 0; i < 200; ++i) {
+		const float cutoff = i % 2 == 0 ? 0.01f : 0.95f;
+		svf.target(StateVariableLowpass(cutoff, 10.0f), 16);
+		svf.feed(signal.begin(), signal.end(), result.begin());
+		REQUIRE(Max(Abs(result)) < 100.0f);
+	}
+}
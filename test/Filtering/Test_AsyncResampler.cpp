@@ -0,0 +1,116 @@
+#include "../TestUtils.hpp"
+
+#include <dspbb/Filtering/AsyncResampler.hpp>
+#include <dspbb/Filtering/Resample.hpp>
+#include <dspbb/Utility/Numbers.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+TEST_CASE("Async resampler matches rational", "[AsyncResampler]") {
+	constexpr size_t numPhases = 16;
+	constexpr size_t filterSize = 255;
+	const Rational<int64_t> sampleRates = { 3, 4 };
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(800);
+	const auto filter = DesignFilter<double, TIME_DOMAIN>(filterSize, Fir.Lowpass.Windowed.Cutoff(ResampleFilterCutoff(sampleRates, numPhases)));
+	const auto polyphase = PolyphaseDecompose(filter, numPhases);
+	const size_t length = floor(ResampleLength(signal.size(), filterSize, numPhases, sampleRates, CONV_FULL));
+	Signal<double> expected(length);
+	Resample(expected, signal, polyphase, sampleRates);
+
+	// The positions fall exactly on branches, so the interpolation has no effect.
+	for (const auto interpolation : { eBranchInterpolation::LINEAR, eBranchInterpolation::CUBIC }) {
+		AsyncResampler<double> resampler{ polyphase, 0.75, interpolation };
+		const auto result = StreamBlocks(resampler, signal, 37);
+		REQUIRE(result.size() > 1000);
+		REQUIRE(Max(Abs(result - AsConstView(expected).subsignal(0, result.size()))) < 1e-9);
+	}
+}
+
+TEST_CASE("Async resampler sine accuracy", "[AsyncResampler]") {
+	constexpr double frequency = 0.1;
+	constexpr double ratio = 147.0 / 160.0 + 1e-5;
+	Signal<double> signal(4000);
+	for (size_t i = 0; i < signal.size(); ++i) {
+		signal[i] = std::sin(2.0 * pi_v<double> * frequency * double(i));
+	}
+
+	const auto measureError = [&](size_t numPhases, eBranchInterpolation interpolation) {
+		const size_t filterSize = numPhases * 32 + 1;
+		const auto filter = DesignFilter<double, TIME_DOMAIN>(filterSize, Fir.Lowpass.Windowed.Cutoff(1.0 / numPhases).Window(windows::blackman));
+		AsyncResampler<double> resampler{ PolyphaseDecompose(filter, numPhases), ratio, interpolation };
+		const auto result = StreamBlocks(resampler, signal, 100);
+		const double delay = double(filterSize - 1) / double(2 * numPhases);
+		double maxError = 0.0;
+		for (size_t i = 200; i < result.size() - 200; ++i) {
+			const double inputPosition = double(i) * ratio - delay;
+			const double expected = std::sin(2.0 * pi_v<double> * frequency * inputPosition);
+			maxError = std::max(maxError, std::abs(result[i] - expected));
+		}
+		return maxError;
+	};
+	const double linearCoarse = measureError(4, eBranchInterpolation::LINEAR);
+	const double cubicCoarse = measureError(4, eBranchInterpolation::CUBIC);
+	const double linearFine = measureError(32, eBranchInterpolation::LINEAR);
+	REQUIRE(linearCoarse < 5e-3);
+	REQUIRE(cubicCoarse < 1e-4);
+	REQUIRE(linearFine < 2e-4);
+	REQUIRE(cubicCoarse < linearCoarse / 10);
+}
+
+TEST_CASE("Async resampler ratio change is continuous", "[AsyncResampler]") {
+	constexpr size_t numPhases = 32;
+	const auto filter = DesignFilter<double, TIME_DOMAIN>(numPhases * 16 + 1, Fir.Lowpass.Windowed.Cutoff(1.0 / numPhases).Window(windows::blackman));
+	AsyncResampler<double> resampler{ PolyphaseNormalized(PolyphaseDecompose(filter, numPhases)), 1.0 };
+	Signal<double> ramp(1000);
+	std::iota(ramp.begin(), ramp.end(), 0.0);
+
+	Signal<double> result;
+	for (size_t position = 0; position < ramp.size(); position += 100) {
+		resampler.set_ratio(position % 200 == 0 ? 1.0 : 1.001);
+		Signal<double> output(resampler.max_output_size(100));
+		const size_t produced = resampler.process(output, AsConstView(ramp).subsignal(position, 100));
+		result.insert(result.end(), output.begin(), output.begin() + produced);
+	}
+	// A resampled ramp is a ramp with a slope of the current ratio, without jumps at block boundaries.
+	for (size_t i = 100; i < result.size() - 50; ++i) {
+		const double slope = result[i] - result[i - 1];
+		REQUIRE(slope == Approx(1.0).epsilon(2e-3));
+	}
+}
+
+TEST_CASE("Fill level controller tracks drift", "[AsyncResampler]") {
+	constexpr size_t numPhases = 16;
+	constexpr size_t blockSize = 480;
+	constexpr double targetFill = 256.0;
+	constexpr double drift = 60e-6;
+	const auto filter = DesignFilter<double, TIME_DOMAIN>(numPhases * 16 + 1, Fir.Lowpass.Windowed.Cutoff(1.0 / numPhases));
+	AsyncResampler<double> resampler{ PolyphaseDecompose(filter, numPhases), 1.0 };
+	FillLevelController controller{ 1.0, targetFill };
+
+	// Prime the buffer, then the producer runs slightly faster than the consumer.
+	Signal<double> output(blockSize);
+	resampler.process(AsView(output).subsignal(0, 0), Signal<double>(size_t(targetFill), 0.0));
+	double carry = 0.0;
+	double averageRatio = 0.0;
+	size_t underruns = 0;
+	for (size_t callback = 0; callback < 3000; ++callback) {
+		const double due = double(blockSize) * (1.0 + drift) + carry;
+		const size_t count = size_t(due);
+		carry = due - double(count);
+		underruns += resampler.process(output, Signal<double>(count, 0.0)) < blockSize;
+		resampler.set_ratio(controller.update(resampler.buffered()));
+		if (callback >= 2000) {
+			averageRatio += controller.ratio() / 1000.0;
+			REQUIRE(resampler.buffered() == Approx(targetFill).margin(4.0));
+		}
+	}
+	// The instantaneous ratio jitters with the whole-sample arrival of the input, but its mean locks to the drift.
+	REQUIRE(underruns == 0);
+	REQUIRE(averageRatio == Approx(1.0 + drift).epsilon(1e-6));
+}
@@ -0,0 +1,126 @@
+#include "../TestUtils.hpp"
+
+#include <dspbb/Filtering/Channelizer.hpp>
+#include <dspbb/Filtering/FIR.hpp>
+#include <dspbb/Math/Statistics.hpp>
+#include <dspbb/Utility/Numbers.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <vector>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+// Mixes each channel down to DC, filters, and keeps every decimation-th sample.
+template <class T>
+std::vector<Signal<std::complex<double>>> ChannelizeDirect(const Signal<T>& input, const Signal<double>& prototype, size_t numChannels, size_t decimation) {
+	const size_t numBlocks = (input.size() + decimation - 1) / decimation;
+	std::vector<Signal<std::complex<double>>> outputs(numChannels, Signal<std::complex<double>>(numBlocks));
+	for (size_t k = 0; k < numChannels; ++k) {
+		for (size_t m = 0; m < numBlocks; ++m) {
+			const int64_t n = int64_t(m * decimation);
+			std::complex<double> sum = 0;
+			for (int64_t l = 0; l < int64_t(prototype.size()) && n - l >= 0; ++l) {
+				const double angle = -2.0 * pi_v<double> * double(k) * double(n - l) / double(numChannels);
+				sum += prototype[l] * std::complex<double>(input[n - l]) * std::polar(1.0, angle);
+			}
+			outputs[k][m] = sum;
+		}
+	}
+	return outputs;
+}
+
+template <class T>
+void TestChannelizer(size_t numChannels, size_t decimation, size_t prototypeSize) {
+	const auto input = RandomSignal<T, TIME_DOMAIN>(400);
+	const auto prototype = RandomSignal<double, TIME_DOMAIN>(prototypeSize);
+	const auto expected = ChannelizeDirect(input, prototype, numChannels, decimation);
+
+	Channelizer<T, double> channelizer(prototype, numChannels, decimation);
+	REQUIRE(channelizer.max_output_size(input.size()) == expected[0].size());
+
+	std::vector<Signal<std::complex<double>>> outputs(numChannels, Signal<std::complex<double>>(expected[0].size()));
+	std::mt19937 rne(62134);
+	std::uniform_int_distribution<size_t> rng(0, 37);
+	size_t inputIndex = 0;
+	size_t outputIndex = 0;
+	while (inputIndex < input.size()) {
+		const size_t count = std::min(input.size() - inputIndex, rng(rne));
+		std::vector<SignalView<std::complex<double>>> views;
+		for (auto& output : outputs) {
+			views.push_back(AsView(output).subsignal(outputIndex));
+		}
+		outputIndex += channelizer.process(views, AsConstView(input).subsignal(inputIndex, count));
+		inputIndex += count;
+	}
+	REQUIRE(outputIndex == expected[0].size());
+	for (size_t k = 0; k < numChannels; ++k) {
+		REQUIRE(Max(Abs(outputs[k] - expected[k])) < 1e-9);
+	}
+}
+
+
+TEST_CASE("Channelizer critically sampled", "[Channelizer]") {
+	TestChannelizer<double>(8, 8, 29);
+	TestChannelizer<double>(8, 8, 32);
+	TestChannelizer<std::complex<double>>(8, 8, 29);
+	TestChannelizer<std::complex<double>>(5, 5, 3);
+}
+
+TEST_CASE("Channelizer oversampled", "[Channelizer]") {
+	TestChannelizer<double>(8, 4, 29);
+	TestChannelizer<std::complex<double>>(8, 2, 40);
+	TestChannelizer<std::complex<double>>(6, 3, 17);
+	TestChannelizer<std::complex<double>>(4, 1, 9);
+}
+
+TEST_CASE("Channelizer partial output", "[Channelizer]") {
+	const auto input = RandomSignal<std::complex<double>, TIME_DOMAIN>(256);
+	const auto prototype = RandomSignal<double, TIME_DOMAIN>(24);
+	const auto expected = ChannelizeDirect(input, prototype, 4, 4);
+
+	Channelizer<std::complex<double>, double> channelizer(prototype, 4, 4);
+	std::vector<Signal<std::complex<double>>> first(4, Signal<std::complex<double>>(10));
+	std::vector<Signal<std::complex<double>>> second(4, Signal<std::complex<double>>(100));
+	REQUIRE(channelizer.process(first, input) == 10);
+	REQUIRE(channelizer.max_output_size(0) == 54);
+	REQUIRE(channelizer.process(second, Signal<std::complex<double>>{}) == 54);
+	for (size_t k = 0; k < 4; ++k) {
+		REQUIRE(Max(Abs(first[k] - AsConstView(expected[k]).subsignal(0, 10))) < 1e-9);
+		REQUIRE(Max(Abs(AsConstView(second[k]).subsignal(0, 54) - AsConstView(expected[k]).subsignal(10))) < 1e-9);
+	}
+
+	channelizer.reset();
+	REQUIRE(channelizer.process(first, input) == 10);
+	REQUIRE(Max(Abs(first[2] - AsConstView(expected[2]).subsignal(0, 10))) < 1e-9);
+}
+
+TEST_CASE("Channelizer separates tones", "[Channelizer]") {
+	constexpr size_t numChannels = 16;
+	const auto prototype = DesignFilter<float, TIME_DOMAIN>(8 * numChannels - 1, Fir.Lowpass.Windowed.Cutoff(1.0f / numChannels).Window(windows::blackman));
+	Signal<std::complex<float>> input(4096);
+	for (size_t n = 0; n < input.size(); ++n) {
+		input[n] = std::polar(1.0f, 2.0f * pi_v<float> * 5.0f * float(n) / float(numChannels));
+	}
+
+	Channelizer<std::complex<float>> channelizer(prototype, numChannels, numChannels);
+	std::vector<Signal<std::complex<float>>> outputs(numChannels, Signal<std::complex<float>>(channelizer.max_output_size(input.size())));
+	const size_t count = channelizer.process(outputs, input);
+	REQUIRE(count == input.size() / numChannels);
+
+	for (size_t k = 0; k < numChannels; ++k) {
+		const auto settled = AsConstView(outputs[k]).subsignal(16);
+		const float level = Mean(Abs(settled));
+		if (k == 5) {
+			REQUIRE(level == Approx(1.0f).epsilon(0.01f));
+		}
+		else {
+			REQUIRE(level < 0.01f);
+		}
+	}
+}
@@ -0,0 +1,170 @@
+#include "../TestUtils.hpp"
+
+#include <dspbb/Filtering/Cic.hpp>
+#include <dspbb/Filtering/DecimatingFir.hpp>
+#include <dspbb/Filtering/Resample.hpp>
+#include <dspbb/Math/Convolution.hpp>
+#include <dspbb/Utility/Numbers.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <complex>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+static Signal<double> CicImpulseResponse(size_t rate, size_t stages, size_t delay) {
+	const Signal<double> boxcar(rate * delay, 1.0);
+	Signal<double> response = { 1.0 };
+	for (size_t i = 0; i < stages; ++i) {
+		response = Convolution(response, boxcar, CONV_FULL);
+	}
+	return response;
+}
+
+static Signal<int> RandomIntegers(size_t size, int range) {
+	const auto random = RandomSignal<double, TIME_DOMAIN>(size);
+	Signal<int> result(size);
+	for (size_t i = 0; i < size; ++i) {
+		result[i] = int(std::round(random[i] * range));
+	}
+	return result;
+}
+
+
+TEST_CASE("CIC decimator float matches FIR", "[Cic]") {
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(1000);
+	for (size_t rate : { 1, 3, 16 }) {
+		for (size_t delay : { 1, 2 }) {
+			const auto expected = DecimatingFir(signal, CicImpulseResponse(rate, 4, delay), rate);
+			CicDecimator<double> decimator{ rate, 4, delay };
+			const auto result = StreamBlocks(decimator, signal, 37);
+			REQUIRE(result.size() == (signal.size() + rate - 1) / rate);
+			REQUIRE(Max(Abs(result - AsConstView(expected).subsignal(0, result.size()))) < 1e-9 * decimator.gain());
+		}
+	}
+}
+
+TEST_CASE("CIC decimator integer matches FIR", "[Cic]") {
+	const auto signal = RandomIntegers(1000, 100);
+	const auto expected = DecimatingFir(Signal<double>(signal.begin(), signal.end()), CicImpulseResponse(8, 3, 1), 8);
+	CicDecimator<int> decimator{ 8, 3 };
+	const auto result = StreamBlocks(decimator, signal, 50);
+	REQUIRE(result.size() == (signal.size() + 7) / 8);
+	for (size_t i = 0; i < result.size(); ++i) {
+		REQUIRE(double(result[i]) == expected[i]);
+	}
+}
+
+TEST_CASE("CIC decimator integer wraps around", "[Cic]") {
+	// The output fits into 16 bits, but the integrators overflow many times.
+	const auto signal = RandomIntegers(20000, 7);
+	const auto expected = DecimatingFir(Signal<double>(signal.begin(), signal.end()), CicImpulseResponse(16, 3, 1), 16);
+	const Signal<int16_t> narrow(signal.begin(), signal.end());
+	CicDecimator<int16_t> decimator{ 16, 3 };
+	const auto result = StreamBlocks(decimator, narrow, 1000);
+	REQUIRE(result.size() == (narrow.size() + 15) / 16);
+	for (size_t i = 0; i < result.size(); ++i) {
+		REQUIRE(double(result[i]) == expected[i]);
+	}
+}
+
+TEST_CASE("CIC decimator partial blocks", "[Cic]") {
+	CicDecimator<float> decimator{ 4, 2 };
+	REQUIRE(decimator.max_output_size(1) == 1);
+	Signal<float> output(4);
+	decimator.process(output, Signal<float>(1, 1.0f));
+	REQUIRE(decimator.max_output_size(3) == 0);
+	REQUIRE(decimator.max_output_size(4) == 1);
+	REQUIRE(decimator.max_output_size(8) == 2);
+	decimator.reset();
+	REQUIRE(decimator.max_output_size(1) == 1);
+}
+
+TEST_CASE("CIC decimator complex", "[Cic]") {
+	const auto signal = RandomSignal<std::complex<float>, TIME_DOMAIN>(200);
+	CicDecimator<std::complex<float>> decimator{ 5, 2 };
+	const auto result = StreamBlocks(decimator, signal, 200);
+	REQUIRE(result.size() == signal.size() / 5);
+	const auto impulse = CicImpulseResponse(5, 2, 1);
+	const auto expected = DecimatingFir(signal, Signal<float>(impulse.begin(), impulse.end()), 5);
+	REQUIRE(Max(Abs(result - AsConstView(expected).subsignal(0, result.size()))) < 1e-4f);
+}
+
+TEST_CASE("CIC decimator float long stream", "[Cic]") {
+	// Uncompensated running sums drift to a few 1e-6 times the gain over the stream.
+	constexpr size_t rate = 256;
+	constexpr size_t stages = 3;
+	constexpr size_t blockSize = 10000;
+	CicDecimator<float> decimator{ rate, stages };
+	CicDecimator<double> reference{ rate, stages };
+	double maxError = 0.0;
+	for (size_t block = 0; block < 1000; ++block) {
+		const auto input = RandomSignal<float, TIME_DOMAIN>(blockSize);
+		Signal<float> output(decimator.max_output_size(blockSize));
+		Signal<double> expected(reference.max_output_size(blockSize));
+		decimator.process(output, input);
+		reference.process(expected, Signal<double>(input.begin(), input.end()));
+		for (size_t i = 0; i < output.size(); ++i) {
+			maxError = std::max(maxError, std::abs(double(output[i]) - expected[i]));
+		}
+	}
+	REQUIRE(maxError < 1e-7 * decimator.gain());
+}
+
+TEST_CASE("CIC interpolator float matches FIR", "[Cic]") {
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(300);
+	for (size_t rate : { 1, 4, 7 }) {
+		const auto expected = Convolution(Expand(signal, rate), CicImpulseResponse(rate, 3, 2), CONV_FULL);
+		CicInterpolator<double> interpolator{ rate, 3, 2 };
+		const auto result = StreamBlocks(interpolator, signal, 29);
+		REQUIRE(result.size() == signal.size() * rate);
+		REQUIRE(Max(Abs(result - AsConstView(expected).subsignal(0, result.size()))) < 1e-9 * interpolator.gain());
+	}
+}
+
+TEST_CASE("CIC interpolator integer matches FIR", "[Cic]") {
+	const auto signal = RandomIntegers(3000, 7);
+	const auto expected = Convolution(Expand(Signal<double>(signal.begin(), signal.end()), 16), CicImpulseResponse(16, 4, 1), CONV_FULL);
+	const Signal<int16_t> narrow(signal.begin(), signal.end());
+	CicInterpolator<int16_t> interpolator{ 16, 4 };
+	const auto result = StreamBlocks(interpolator, narrow, 100);
+	REQUIRE(result.size() == narrow.size() * 16);
+	for (size_t i = 0; i < result.size(); ++i) {
+		REQUIRE(double(result[i]) == expected[i]);
+	}
+}
+
+TEST_CASE("CIC response", "[Cic]") {
+	REQUIRE(CicResponse(0.0, 16, 4) == 1.0);
+	REQUIRE(CicResponse(0.5, 16, 4) < 1.0);
+	// Nulls at multiples of the low rate.
+	REQUIRE(CicResponse(2.0, 16, 4) == Approx(0.0).margin(1e-12));
+	const auto impulse = CicImpulseResponse(16, 4, 1);
+	double real = 0.0;
+	double imag = 0.0;
+	for (size_t i = 0; i < impulse.size(); ++i) {
+		real += impulse[i] * std::cos(pi_v<double> * 0.3 / 16.0 * double(i));
+		imag += impulse[i] * std::sin(pi_v<double> * 0.3 / 16.0 * double(i));
+	}
+	REQUIRE(CicResponse(0.3, 16, 4) == Approx(std::hypot(real, imag) / std::pow(16.0, 4.0)));
+}
+
+TEST_CASE("CIC compensation flattens passband", "[Cic]") {
+	constexpr size_t rate = 64;
+	constexpr size_t stages = 4;
+	const auto compensation = DesignCicCompensation<double, TIME_DOMAIN>(41, rate, stages, 1, 0.4, 0.7);
+	for (double f = 0.0; f <= 0.4; f += 0.01) {
+		double real = 0.0;
+		double imag = 0.0;
+		for (size_t i = 0; i < compensation.size(); ++i) {
+			real += compensation[i] * std::cos(pi_v<double> * f * double(i));
+			imag += compensation[i] * std::sin(pi_v<double> * f * double(i));
+		}
+		const double combined = std::hypot(real, imag) * CicResponse(f, rate, stages);
+		REQUIRE(combined == Approx(1.0).margin(0.02));
+	}
+}
@@ -0,0 +1,73 @@
+#include "../TestUtils.hpp"
+
+#include <dspbb/Filtering/DecimatingFir.hpp>
+#include <dspbb/Filtering/Resample.hpp>
+#include <dspbb/Math/Convolution.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+TEST_CASE("Decimating FIR length", "[DecimatingFir]") {
+	REQUIRE(DecimatingFirLength(100, 11, 4) == 28);
+	REQUIRE(DecimatingFirLength(100, 11, 1) == 110);
+	REQUIRE(DecimatingFirLength(3, 2, 8) == 1);
+}
+
+TEST_CASE("Decimating FIR matches filter and drop", "[DecimatingFir]") {
+	const auto signal = RandomSignal<float, TIME_DOMAIN>(500);
+	for (size_t filterSize : { 1, 5, 16, 63 }) {
+		const auto filter = RandomSignal<float, TIME_DOMAIN>(filterSize);
+		for (size_t rate : { 1, 2, 3, 7, 64 }) {
+			const auto expected = Decimate(Convolution(signal, filter, CONV_FULL), rate);
+			const auto result = DecimatingFir(signal, filter, rate);
+			REQUIRE(result.size() == expected.size());
+			REQUIRE(Max(Abs(result - expected)) < 1e-4f);
+		}
+	}
+}
+
+TEST_CASE("Decimating FIR partial output", "[DecimatingFir]") {
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(300);
+	const auto filter = RandomSignal<double, TIME_DOMAIN>(40);
+	const auto expected = DecimatingFir(signal, filter, 6);
+	Signal<double> result(20);
+	DecimatingFir(result, signal, filter, 6);
+	REQUIRE(Max(Abs(result - AsConstView(expected).subsignal(0, 20))) < 1e-12);
+}
+
+TEST_CASE("Streaming decimating FIR matches batch", "[DecimatingFir]") {
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(1000);
+	for (size_t rate : { 1, 4, 5, 64 }) {
+		const auto filter = RandomSignal<double, TIME_DOMAIN>(3 * rate + 2);
+		const auto expected = DecimatingFir(signal, filter, rate);
+
+		StreamingDecimatingFir<double> decimator{ filter, rate };
+		const auto result = StreamBlocks(decimator, signal, { 1, 13, 64, 7, 200 });
+		REQUIRE(result.size() == (signal.size() + rate - 1) / rate);
+		REQUIRE(Max(Abs(result - AsConstView(expected).subsignal(0, result.size()))) < 1e-12);
+	}
+}
+
+TEST_CASE("Streaming decimating FIR small output", "[DecimatingFir]") {
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(400);
+	const auto filter = RandomSignal<double, TIME_DOMAIN>(17);
+	const auto expected = DecimatingFir(signal, filter, 4);
+
+	StreamingDecimatingFir<double> decimator{ filter, 4 };
+	Signal<double> result;
+	Signal<double> output(3);
+	for (size_t i = 0; i < signal.size(); i += 40) {
+		const size_t produced = decimator.process(output, AsConstView(signal).subsignal(i, 40));
+		result.insert(result.end(), output.begin(), output.begin() + produced);
+	}
+	for (size_t produced = decimator.process(output, Signal<double>{}); produced > 0; produced = decimator.process(output, Signal<double>{})) {
+		result.insert(result.end(), output.begin(), output.begin() + produced);
+	}
+	REQUIRE(result.size() == 100);
+	REQUIRE(Max(Abs(result - AsConstView(expected).subsignal(0, 100))) < 1e-12);
+}
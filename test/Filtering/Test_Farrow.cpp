@@ -0,0 +1,120 @@
+#include "../TestUtils.hpp"
+
+#include <dspbb/Filtering/FIR.hpp>
+#include <dspbb/Filtering/Farrow.hpp>
+#include <dspbb/Math/Functions.hpp>
+#include <dspbb/Math/Statistics.hpp>
+#include <dspbb/Utility/Numbers.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+TEST_CASE("Farrow Lagrange integer delay", "[Farrow]") {
+	const auto filter = DesignFarrowLagrange<double>(4);
+	REQUIRE(filter.size() == 4);
+	REQUIRE(filter.order() == 3);
+	REQUIRE(filter.delay() == 1.0);
+
+	Signal<double> taps(4);
+	filter.Evaluate(taps, 0.0);
+	REQUIRE(Max(Abs(taps - Signal<double>{ 0, 1, 0, 0 })) < 1e-12);
+	filter.Evaluate(taps, 1.0);
+	REQUIRE(Max(Abs(taps - Signal<double>{ 0, 0, 1, 0 })) < 1e-12);
+}
+
+TEST_CASE("Farrow Lagrange delays polynomials exactly", "[Farrow]") {
+	const auto filter = DesignFarrowLagrange<double>(5);
+	REQUIRE(filter.delay() == 1.5);
+	Signal<double> input(40);
+	for (size_t n = 0; n < input.size(); ++n) {
+		const double t = double(n) / 10.0;
+		input[n] = 1.0 - 2.0 * t + 0.5 * t * t - 0.25 * t * t * t + 0.1 * t * t * t * t;
+	}
+	FarrowDelay<double> delay(filter, 6.0);
+	for (double amount : { 1.5, 1.75, 2.2, 3.0, 5.9 }) {
+		delay.reset();
+		Signal<double> output(input.size());
+		delay.process(output, input, amount);
+		for (size_t n = 10; n < input.size(); ++n) {
+			const double t = (double(n) - amount) / 10.0;
+			const double expected = 1.0 - 2.0 * t + 0.5 * t * t - 0.25 * t * t * t + 0.1 * t * t * t * t;
+			REQUIRE(output[n] == Approx(expected).margin(1e-9));
+		}
+	}
+}
+
+TEST_CASE("Farrow fitted to prototype", "[Farrow]") {
+	constexpr size_t size = 16;
+	constexpr size_t oversampling = 32;
+	const auto prototype = DesignFilter<double, TIME_DOMAIN>(size * oversampling + 1, Fir.Lowpass.Windowed.Cutoff(0.8 / oversampling).Window(windows::blackman));
+	const auto filter = DesignFarrow<float>(prototype, oversampling, 5);
+	REQUIRE(filter.size() == size);
+	REQUIRE(filter.order() == 5);
+
+	Signal<float> input(400);
+	const float frequency = 0.05f;
+	for (size_t n = 0; n < input.size(); ++n) {
+		input[n] = std::sin(2.0f * pi_v<float> * frequency * float(n));
+	}
+	FarrowDelay<float> delay(filter, 20.0f);
+	for (float amount : { 7.0f, 7.3f, 7.5f, 12.81f, 19.99f }) {
+		delay.reset();
+		Signal<float> output(input.size());
+		delay.process(output, input, amount);
+		for (size_t n = 40; n < input.size(); ++n) {
+			const float expected = std::sin(2.0f * pi_v<float> * frequency * (float(n) - amount));
+			REQUIRE(output[n] == Approx(expected).margin(2e-3f));
+		}
+	}
+}
+
+TEST_CASE("Farrow varying delay", "[Farrow]") {
+	const auto filter = DesignFarrowLagrange<double>(6);
+	const auto input = RandomSignal<std::complex<double>, TIME_DOMAIN>(300);
+	Signal<double> delays(input.size());
+	for (size_t n = 0; n < delays.size(); ++n) {
+		delays[n] = 2.0 + 3.0 * (0.5 + 0.5 * std::sin(double(n) / 17.0));
+	}
+
+	// Each sample must be the same as with that sample's delay held constant.
+	FarrowDelay<std::complex<double>, double> varying(filter, 5.0);
+	Signal<std::complex<double>> output(input.size());
+	std::mt19937 rne(8832);
+	std::uniform_int_distribution<size_t> rng(0, 23);
+	for (size_t first = 0; first < input.size();) {
+		const size_t count = std::min(input.size() - first, rng(rne));
+		varying.process(AsView(output).subsignal(first, count), AsConstView(input).subsignal(first, count), AsConstView(delays).subsignal(first, count));
+		first += count;
+	}
+
+	FarrowDelay<std::complex<double>, double> constant(filter, 5.0);
+	Signal<std::complex<double>> expected(input.size());
+	for (size_t n = 0; n < input.size(); n += 37) {
+		constant.reset();
+		constant.process(expected, input, delays[n]);
+		REQUIRE(std::abs(output[n] - expected[n]) < 1e-12);
+	}
+}
+
+TEST_CASE("Farrow streaming constant delay", "[Farrow]") {
+	const auto filter = DesignFarrowLagrange<float>(4);
+	const auto input = RandomSignal<float, TIME_DOMAIN>(200);
+	FarrowDelay<float> whole(filter, 3.0f);
+	Signal<float> expected(input.size());
+	whole.process(expected, input, 2.4f);
+
+	FarrowDelay<float> blocks(filter, 3.0f);
+	Signal<float> output(input.size());
+	for (size_t first = 0; first < input.size(); first += 13) {
+		const size_t count = std::min(input.size() - first, size_t(13));
+		blocks.process(AsView(output).subsignal(first, count), AsConstView(input).subsignal(first, count), 2.4f);
+	}
+	REQUIRE(Max(Abs(output - expected)) < 1e-6f);
+}
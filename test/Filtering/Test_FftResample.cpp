@@ -0,0 +1,108 @@
+#include "../TestUtils.hpp"
+
+#include <dspbb/Filtering/FftResample.hpp>
+#include <dspbb/Math/FFT.hpp>
+#include <dspbb/Utility/Numbers.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <complex>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+template <class T>
+static Signal<T> PeriodicTone(size_t length, double cycles, double phase) {
+	Signal<T> signal(length);
+	for (size_t i = 0; i < length; ++i) {
+		const double x = 2.0 * pi_v<double> * cycles * double(i) / double(length) + phase;
+		if constexpr (is_complex_v<T>) {
+			signal[i] = T(std::cos(x), std::sin(x));
+		}
+		else {
+			signal[i] = T(std::cos(x));
+		}
+	}
+	return signal;
+}
+
+
+TEST_CASE("FFT fast length", "[FftResample]") {
+	REQUIRE(FftFastLength(0) == 1);
+	REQUIRE(FftFastLength(1) == 1);
+	REQUIRE(FftFastLength(11) == 12);
+	REQUIRE(FftFastLength(64) == 64);
+	REQUIRE(FftFastLength(1031) == 1050);
+}
+
+TEST_CASE("FFT resample periodic tone", "[FftResample]") {
+	for (size_t inputLength : { 64, 65, 100 }) {
+		for (size_t outputLength : { 30, 31, 64, 65, 160, 257 }) {
+			const double cycles = 7.0;
+			const auto input = PeriodicTone<double>(inputLength, cycles, 0.3);
+			const auto expected = PeriodicTone<double>(outputLength, cycles, 0.3);
+			const auto result = FftResample(input, outputLength);
+			REQUIRE(result.size() == outputLength);
+			REQUIRE(Max(Abs(result - expected)) < 1e-9);
+		}
+	}
+}
+
+TEST_CASE("FFT resample complex tone", "[FftResample]") {
+	for (size_t inputLength : { 64, 65 }) {
+		for (size_t outputLength : { 31, 32, 200, 201 }) {
+			for (double cycles : { -9.0, 5.0 }) {
+				const auto input = PeriodicTone<std::complex<double>>(inputLength, cycles, 0.7);
+				const auto expected = PeriodicTone<std::complex<double>>(outputLength, cycles, 0.7);
+				const auto result = FftResample(input, outputLength);
+				REQUIRE(Max(Abs(result - expected)) < 1e-9);
+			}
+		}
+	}
+}
+
+TEST_CASE("FFT resample Nyquist component", "[FftResample]") {
+	// The alternating signal is split between +N/2 and -N/2 when upsampling.
+	const Signal<double> alternating = { 1, -1, 1, -1 };
+	const auto up = FftResample(alternating, 8);
+	const Signal<double> expectedUp = { 1, 0, -1, 0, 1, 0, -1, 0 };
+	REQUIRE(Max(Abs(up - expectedUp)) < 1e-12);
+
+	// A tone at 2 cycles folds onto the Nyquist bin when downsampling to 4.
+	const auto tone = PeriodicTone<double>(12, 2.0, 0.0);
+	const auto down = FftResample(tone, 4);
+	REQUIRE(Max(Abs(down - alternating)) < 1e-12);
+}
+
+TEST_CASE("FFT resample identity", "[FftResample]") {
+	const auto signal = RandomSignal<float, TIME_DOMAIN>(77);
+	const auto result = FftResample(signal, signal.size());
+	REQUIRE(Max(Abs(result - signal)) < 1e-5f);
+}
+
+TEST_CASE("FFT resample round trip", "[FftResample]") {
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(100);
+	const auto result = FftResample(FftResample(signal, 250), 100);
+	REQUIRE(Max(Abs(result - signal)) < 1e-9);
+}
+
+TEST_CASE("FFT resample frequency window", "[FftResample]") {
+	const auto low = PeriodicTone<double>(128, 1.0, 0.0);
+	const auto high = PeriodicTone<double>(128, 60.0, 0.0);
+	const auto result = FftResample(low + high, 256, windows::blackman);
+	// The window barely affects the low tone and removes most of the high tone.
+	const auto expected = PeriodicTone<double>(256, 1.0, 0.0);
+	REQUIRE(Max(Abs(result - expected)) < 0.05);
+}
+
+TEST_CASE("FFT resample real to complex", "[FftResample]") {
+	const auto input = PeriodicTone<float>(50, 3.0, 0.0);
+	Signal<std::complex<float>> output(75);
+	FftResample(output, input);
+	const auto expected = PeriodicTone<float>(75, 3.0, 0.0);
+	REQUIRE(Max(Abs(Real(output) - expected)) < 1e-5f);
+	REQUIRE(Max(Abs(Imag(output))) < 1e-5f);
+}
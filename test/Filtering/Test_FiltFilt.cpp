@@ -0,0 +1,131 @@
+#include "../TestUtils.hpp"
+
+#include <dspbb/Filtering/FIR.hpp>
+#include <dspbb/Filtering/FiltFilt.hpp>
+#include <dspbb/Filtering/IIR.hpp>
+#include <dspbb/Generators/Waveforms.hpp>
+#include <dspbb/Math/Functions.hpp>
+#include <dspbb/Math/Statistics.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+//------------------------------------------------------------------------------
+// Steady state
+//------------------------------------------------------------------------------
+
+TEST_CASE("Steady state direct form I", "[FiltFilt]") {
+	const auto filter = TransferFunction(DesignFilter<double>(5, Iir.Lowpass.Butterworth.Cutoff(0.3)));
+	DirectFormI<double> state{ filter.order() };
+	state.reset(2.0, filter);
+	for (int i = 0; i < 16; ++i) {
+		REQUIRE(state.feed(2.0, filter) == Approx(2.0));
+	}
+}
+
+TEST_CASE("Steady state direct form II", "[FiltFilt]") {
+	const auto filter = TransferFunction(DesignFilter<double>(5, Iir.Lowpass.Butterworth.Cutoff(0.3)));
+	DirectFormII<double> state{ filter.order() };
+	state.reset(2.0, filter);
+	for (int i = 0; i < 16; ++i) {
+		REQUIRE(state.feed(2.0, filter) == Approx(2.0));
+	}
+}
+
+TEST_CASE("Steady state cascaded form", "[FiltFilt]") {
+	const auto filter = CascadedBiquad(DesignFilter<double>(5, Iir.Highpass.Chebyshev1.Cutoff(0.3).PassbandRipple(0.1)));
+	CascadedForm<double> state{ filter.order() };
+	state.reset(2.0, filter);
+	for (int i = 0; i < 16; ++i) {
+		REQUIRE(state.feed(2.0, filter) == Approx(0.0).margin(1e-9));
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Zero-phase filtering
+//------------------------------------------------------------------------------
+
+TEST_CASE("FiltFilt IIR constant", "[FiltFilt]") {
+	const auto filter = CascadedBiquad(DesignFilter<double>(6, Iir.Lowpass.Butterworth.Cutoff(0.2)));
+	const Signal<double> signal(256, 3.0);
+	const auto filtered = FiltFilt(signal, filter);
+	REQUIRE(Min(filtered) == Approx(3.0));
+	REQUIRE(Max(filtered) == Approx(3.0));
+}
+
+TEST_CASE("FiltFilt IIR zero phase", "[FiltFilt]") {
+	const auto filter = CascadedBiquad(DesignFilter<double>(6, Iir.Lowpass.Butterworth.Cutoff(0.3)));
+	const auto signal = SineWave<double, TIME_DOMAIN>(1024, 1024, 20);
+	const auto filtered = FiltFilt(signal, filter);
+	const auto diff = filtered - signal;
+	REQUIRE(Max(Abs(AsConstView(diff).subsignal(100, 824))) < 1e-3);
+}
+
+TEST_CASE("FiltFilt transfer function matches cascade", "[FiltFilt]") {
+	const auto zpk = DesignFilter<double>(4, Iir.Lowpass.Butterworth.Cutoff(0.25));
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(500);
+	const auto filteredTf = FiltFilt(signal, TransferFunction(zpk));
+	const auto filteredSos = FiltFilt(signal, CascadedBiquad(zpk));
+	for (size_t i = 0; i < signal.size(); ++i) {
+		REQUIRE(filteredTf[i] == Approx(filteredSos[i]).margin(1e-6));
+	}
+}
+
+TEST_CASE("FiltFilt IIR parallel", "[FiltFilt]") {
+	const auto filter = CascadedBiquad(DesignFilter<double>(6, Iir.Lowpass.Butterworth.Cutoff(0.2)));
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(3000);
+	const auto serial = FiltFilt(signal, filter);
+	const auto parallel = FiltFilt(signal, filter, 4);
+	for (size_t i = 0; i < signal.size(); ++i) {
+		REQUIRE(parallel[i] == Approx(serial[i]).margin(1e-6));
+	}
+}
+
+TEST_CASE("FiltFilt FIR", "[FiltFilt]") {
+	const auto filter = DesignFilter<double, TIME_DOMAIN>(31, Fir.Lowpass.Windowed.Cutoff(0.3));
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(400);
+
+	const size_t pad = 3 * filter.size();
+	Signal<double> extended(signal.size() + 2 * pad);
+	for (size_t i = 0; i < extended.size(); ++i) {
+		const ptrdiff_t idx = ptrdiff_t(i) - ptrdiff_t(pad);
+		const ptrdiff_t last = ptrdiff_t(signal.size()) - 1;
+		if (idx < 0) {
+			extended[i] = 2 * signal[0] - signal[-idx];
+		}
+		else if (idx > last) {
+			extended[i] = 2 * signal[last] - signal[2 * last - idx];
+		}
+		else {
+			extended[i] = signal[idx];
+		}
+	}
+	Signal<double> forward(extended.size());
+	Signal<double> backward(extended.size());
+	Signal<double> state(filter.size() - 1, extended[0]);
+	Filter(forward, extended, filter, state, FILTER_CONV);
+	std::reverse(forward.begin(), forward.end());
+	state = Signal<double>(filter.size() - 1, forward[0]);
+	Filter(backward, forward, filter, state, FILTER_CONV);
+	std::reverse(backward.begin(), backward.end());
+
+	const auto serial = FiltFilt(signal, filter);
+	const auto parallel = FiltFilt(signal, filter, 3);
+	for (size_t i = 0; i < signal.size(); ++i) {
+		REQUIRE(serial[i] == Approx(backward[i + pad]));
+		REQUIRE(parallel[i] == Approx(serial[i]));
+	}
+}
+
+TEST_CASE("FiltFilt short signal", "[FiltFilt]") {
+	const auto filter = CascadedBiquad(DesignFilter<double>(6, Iir.Lowpass.Butterworth.Cutoff(0.2)));
+	const Signal<double> signal = { 1.0, 2.0, 3.0 };
+	const auto filtered = FiltFilt(signal, filter);
+	REQUIRE(filtered.size() == signal.size());
+}
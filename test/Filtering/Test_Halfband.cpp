@@ -0,0 +1,92 @@
+#include "../TestUtils.hpp"
+
+#include <dspbb/Filtering/DecimatingFir.hpp>
+#include <dspbb/Filtering/FIR.hpp>
+#include <dspbb/Filtering/Halfband.hpp>
+#include <dspbb/Filtering/MeasureFilter.hpp>
+#include <dspbb/Filtering/Polyphase.hpp>
+#include <dspbb/Filtering/Resample.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+TEST_CASE("Halfband from filter", "[Halfband]") {
+	const Signal<float> filter = { 1, 0, 2, 5, 2, 0, 1 };
+	const HalfbandFilter<float> halfband{ filter };
+	REQUIRE(halfband.size() == 7);
+	REQUIRE(halfband.delay() == 3);
+	REQUIRE(halfband.taps().size() == 2);
+	REQUIRE(halfband.taps()[0] == 1);
+	REQUIRE(halfband.taps()[1] == 2);
+	REQUIRE(halfband.center() == 5);
+	REQUIRE(Max(Abs(halfband.full() - filter)) == 0);
+}
+
+TEST_CASE("Halfband design windowed", "[Halfband]") {
+	const auto halfband = DesignHalfband<double>(31, Fir.Lowpass.Windowed.Window(windows::blackman));
+	const auto full = halfband.full();
+	const auto reference = DesignFilter<double, TIME_DOMAIN>(31, Fir.Lowpass.Windowed.Cutoff(0.5).Window(windows::blackman));
+	REQUIRE(halfband.center() == 0.5);
+	REQUIRE(Sum(full) == Approx(1.0));
+	REQUIRE(Max(Abs(full - reference)) < 1e-3);
+}
+
+TEST_CASE("Halfband design least squares", "[Halfband]") {
+	const auto halfband = DesignHalfband<double>(47, Fir.Lowpass.LeastSquares.Cutoff(0.4, 0.5));
+	const auto full = halfband.full();
+	REQUIRE(halfband.center() == 0.5);
+	REQUIRE(Sum(full) == Approx(1.0));
+	// The transition band is centred on 0.5, so 0.45 to 0.55 is used.
+	const auto [amplitude, phase] = FrequencyResponse(full);
+	const auto params = MeasureLowpassFilter(amplitude);
+	REQUIRE(params.passbandEdge > 0.4);
+	REQUIRE(params.stopbandEdge < 0.6);
+	REQUIRE(params.stopbandAtten < 0.01);
+}
+
+TEST_CASE("Halfband decimate matches decimating FIR", "[Halfband]") {
+	const auto signal = RandomSignal<float, TIME_DOMAIN>(301);
+	for (size_t size : { 3, 7, 23, 63 }) {
+		const auto halfband = DesignHalfband<float>(size, Fir.Lowpass.Windowed);
+		const auto expected = DecimatingFir(signal, halfband.full(), 2);
+		const auto result = HalfbandDecimate(signal, halfband);
+		REQUIRE(result.size() == expected.size());
+		REQUIRE(Max(Abs(result - expected)) < 1e-5f);
+	}
+}
+
+TEST_CASE("Halfband decimate short input", "[Halfband]") {
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(5);
+	const auto halfband = DesignHalfband<double>(23, Fir.Lowpass.Windowed);
+	const auto expected = DecimatingFir(signal, halfband.full(), 2);
+	const auto result = HalfbandDecimate(signal, halfband);
+	REQUIRE(Max(Abs(result - expected)) < 1e-12);
+}
+
+TEST_CASE("Halfband interpolate matches polyphase", "[Halfband]") {
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(200);
+	for (size_t size : { 3, 11, 47 }) {
+		const auto halfband = DesignHalfband<double>(size, Fir.Lowpass.Windowed);
+		const auto polyphase = PolyphaseDecompose(halfband.full(), 2);
+		const size_t length = InterpolLength(signal.size(), size, 2, CONV_FULL);
+		for (size_t offset : { size_t(0), size_t(5), size_t(120) }) {
+			const auto expected = Interpolate(signal, polyphase, offset, length - offset);
+			const auto result = HalfbandInterpolate(signal, halfband, offset, length - offset);
+			REQUIRE(Max(Abs(result - expected)) < 1e-12);
+		}
+	}
+}
+
+TEST_CASE("Halfband interpolate odd samples are delayed input", "[Halfband]") {
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(100);
+	const auto halfband = DesignHalfband<double>(19, Fir.Lowpass.Windowed);
+	const auto result = HalfbandInterpolate(signal, halfband, 0, 200);
+	for (size_t i = halfband.delay(); i < result.size(); i += 2) {
+		REQUIRE(result[i] == signal[(i - halfband.delay()) / 2]);
+	}
+}
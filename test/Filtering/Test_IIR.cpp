@@ -62,6 +62,44 @@ TEST_CASE("Filter continuity", "[IIR]") {
 	REQUIRE(Max(Abs(result - expected)) < 1e-4f);
 }
 
+// The flush only works where the floating point control register is accessible.
+#if defined(DSPBB_DENORMALS_SSE) || defined(DSPBB_DENORMALS_AARCH64)
+TEST_CASE("Filter flush denormals", "[IIR]") {
+	constexpr int order = 4;
+	const auto filter = CascadedBiquad(DesignFilter<float>(order, Iir.Lowpass.Butterworth.Cutoff(0.3f)));
+	CascadedForm<float> state{ order };
+	BasicSignal<float, TIME_DOMAIN> signal(20000, 0.0f);
+	signal[0] = 1.0f;
+	const auto filtered = Filter(signal, filter, state);
+	for (auto& value : filtered) {
+		REQUIRE((value == 0.0f || std::abs(value) >= std::numeric_limits<float>::min()));
+	}
+}
+#endif
+
+TEST_CASE("Filter DC offset denormals", "[IIR]") {
+	constexpr int order = 7;
+	const auto filter = TransferFunction(DesignFilter<float>(order, Iir.Lowpass.Butterworth.Cutoff(0.3f)));
+	DirectFormII<float> state{ order };
+	const auto signal = RandomSignal<float, TIME_DOMAIN>(1000);
+	const auto expected = Filter(signal, filter, state, eDenormalHandling::KEEP);
+	state.reset();
+	const auto result = Filter(signal, filter, state, eDenormalHandling::DC_OFFSET);
+	REQUIRE(Max(Abs(result - expected)) < 1e-6f);
+}
+
+TEST_CASE("Filter DC offset keeps decay normal", "[IIR]") {
+	constexpr int order = 7;
+	const auto filter = TransferFunction(DesignFilter<float>(order, Iir.Lowpass.Butterworth.Cutoff(0.3f)));
+	DirectFormII<float> state{ order };
+	BasicSignal<float, TIME_DOMAIN> signal(20000, 0.0f);
+	signal[0] = 1.0f;
+	const auto filtered = Filter(signal, filter, state, eDenormalHandling::DC_OFFSET);
+	for (auto& value : filtered) {
+		REQUIRE(std::abs(value) >= std::numeric_limits<float>::min());
+	}
+}
+
 
 //------------------------------------------------------------------------------
 // Butterworth method
@@ -1,3 +1,4 @@
+#include <dspbb/Filtering/IIR.hpp>
 #include <dspbb/Filtering/MeasureFilter.hpp>
 #include <dspbb/Generators/Spaces.hpp>
 #include <dspbb/Math/DotProduct.hpp>
@@ -378,4 +379,53 @@ TEST_CASE("FIR frequency response size", "[FilterParameters]") {
 
 	const float similarity = DotProduct(amplitude, expected) / Norm(amplitude) / Norm(expected);
 	REQUIRE(similarity == Approx(1).epsilon(5e-3f));
-}
\ No newline at end of file
+}
+
+//------------------------------------------------------------------------------
+// System frequency response
+//------------------------------------------------------------------------------
+
+TEST_CASE("System frequency response at frequencies", "[FilterParameters]") {
+	const auto zpk = DesignFilter<double>(6, Iir.Bandpass.Elliptic.Band(0.3, 0.5).PassbandRipple(0.05).StopbandRipple(0.05));
+	const auto tf = TransferFunction(zpk);
+	const auto sos = CascadedBiquad(zpk);
+	const auto frequencies = LinSpace<double, FREQUENCY_DOMAIN>(0.0, 1.0, 101, true);
+
+	const auto responseZpk = FrequencyResponse(zpk, frequencies);
+	const auto responseTf = FrequencyResponse(tf, frequencies);
+	const auto responseSos = FrequencyResponse(sos, frequencies);
+	REQUIRE(responseZpk.size() == frequencies.size());
+
+	for (size_t i = 0; i < frequencies.size(); ++i) {
+		const auto point = std::polar(1.0, frequencies[i] * pi_v<double>);
+		const auto expected = zpk(point);
+		REQUIRE(std::abs(responseZpk[i] - expected) < 1e-9);
+		REQUIRE(std::abs(responseTf[i] - expected) < 1e-6);
+		REQUIRE(std::abs(responseSos[i] - expected) < 1e-9);
+	}
+}
+
+TEST_CASE("System frequency response odd sections", "[FilterParameters]") {
+	const auto sos = CascadedBiquad(DesignFilter<float>(5, Iir.Highpass.Chebyshev2.Cutoff(0.4f).StopbandRipple(0.1f)));
+	const auto frequencies = LinSpace<float, FREQUENCY_DOMAIN>(0.0f, 1.0f, 37, true);
+	const auto response = FrequencyResponse(sos, frequencies);
+	for (size_t i = 0; i < frequencies.size(); ++i) {
+		const auto expected = sos(std::polar(1.0f, frequencies[i] * pi_v<float>));
+		REQUIRE(std::abs(response[i] - expected) < 1e-4f);
+	}
+}
+
+TEST_CASE("Transfer function frequency response FFT grid", "[FilterParameters]") {
+	const auto tf = TransferFunction(DesignFilter<double>(6, Iir.Lowpass.Chebyshev1.Cutoff(0.4).PassbandRipple(0.1)));
+	const auto [amplitude, phase] = FrequencyResponse(tf, 50);
+	REQUIRE(amplitude.size() == 50);
+	REQUIRE(phase.size() == 50);
+	for (size_t i = 0; i < amplitude.size(); ++i) {
+		const auto point = std::polar(1.0, double(i) / double(amplitude.size() - 1) * pi_v<double>);
+		const auto expected = tf(point);
+		REQUIRE(amplitude[i] == Approx(std::abs(expected)).margin(1e-9));
+		if (std::abs(expected) > 1e-6) {
+			REQUIRE(std::abs(std::polar(1.0, phase[i]) - std::polar(1.0, std::arg(expected))) < 1e-6);
+		}
+	}
+}
@@ -0,0 +1,105 @@
+#include "../TestUtils.hpp"
+
+#include <dspbb/Filtering/DecimatingFir.hpp>
+#include <dspbb/Filtering/FIR.hpp>
+#include <dspbb/Filtering/Mixer.hpp>
+#include <dspbb/Generators/Waveforms.hpp>
+#include <dspbb/Math/Functions.hpp>
+#include <dspbb/Math/Statistics.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+constexpr uint64_t sampleRate = 48000;
+
+
+template <class T>
+Signal<std::complex<double>> MixDirect(const Signal<T>& input, double frequency, double phase) {
+	Signal<std::complex<double>> output(input.size());
+	for (size_t n = 0; n < input.size(); ++n) {
+		const double angle = 2.0 * pi_v<double> * frequency * double(n) / double(sampleRate) + phase;
+		output[n] = std::complex<double>(input[n]) * std::polar(1.0, angle);
+	}
+	return output;
+}
+
+
+TEST_CASE("Mixer real input", "[Mixer]") {
+	const auto input = RandomSignal<double, TIME_DOMAIN>(3000);
+	const auto expected = MixDirect(input, 1234.5, 0.7);
+
+	Mixer<double> mixer(sampleRate, 1234.5, 0.7);
+	Signal<std::complex<double>> output(input.size());
+	for (size_t first = 0; first < input.size(); first += 77) {
+		const size_t count = std::min(input.size() - first, size_t(77));
+		mixer.process(AsView(output).subsignal(first, count), AsConstView(input).subsignal(first, count));
+	}
+	REQUIRE(Max(Abs(output - expected)) < 1e-12);
+}
+
+TEST_CASE("Mixer complex input in place", "[Mixer]") {
+	const auto input = RandomSignal<std::complex<float>, TIME_DOMAIN>(3000);
+	const auto expected = MixDirect(input, -5000.0, 0.0);
+
+	Mixer<std::complex<float>> mixer(sampleRate, -5000.0);
+	Signal<std::complex<float>> output = input;
+	mixer.process(output, output);
+	for (size_t n = 0; n < output.size(); ++n) {
+		REQUIRE(std::abs(std::complex<double>(output[n]) - expected[n]) < 1e-5);
+	}
+}
+
+TEST_CASE("Mixer retune and reset", "[Mixer]") {
+	const Signal<float> ones(100, 1.0f);
+	Mixer<float> mixer(sampleRate, 1000.0);
+	Signal<std::complex<float>> first(100);
+	Signal<std::complex<float>> second(100);
+	mixer.process(first, ones);
+	const double phase = mixer.phase();
+	mixer.set_frequency(3000.0);
+	REQUIRE(mixer.frequency() == Approx(3000.0));
+	mixer.process(second, ones);
+	REQUIRE(std::arg(second[0]) == Approx(std::remainder(phase, 2.0 * pi_v<double>)).margin(1e-5));
+
+	mixer.reset();
+	mixer.process(second, ones);
+	REQUIRE(Max(Abs(second - first)) < 1e-6f);
+}
+
+TEST_CASE("Downconverter matches mix and decimate", "[Mixer]") {
+	const auto input = RandomSignal<float, TIME_DOMAIN>(5000);
+	const auto filter = DesignFilter<float, TIME_DOMAIN>(63, Fir.Lowpass.Windowed.Cutoff(0.1f));
+	const auto mixed = MixDirect(input, -7000.0, 0.0);
+	const auto expected = DecimatingFir(mixed, Signal<double>(filter.begin(), filter.end()), 8);
+
+	DownConverter<float> converter(sampleRate, 7000.0, filter, 8);
+	REQUIRE(converter.center_frequency() == Approx(7000.0));
+	REQUIRE(converter.decimation() == 8);
+	Signal<std::complex<float>> output(converter.max_output_size(input.size()));
+	size_t written = 0;
+	for (size_t first = 0; first < input.size(); first += 1500) {
+		const size_t count = std::min(input.size() - first, size_t(1500));
+		written += converter.process(AsView(output).subsignal(written), AsConstView(input).subsignal(first, count));
+	}
+	REQUIRE(written == (input.size() + 7) / 8);
+	for (size_t n = 0; n < written; ++n) {
+		REQUIRE(std::abs(std::complex<double>(output[n]) - expected[n]) < 1e-4);
+	}
+}
+
+TEST_CASE("Downconverter tunes tone to DC", "[Mixer]") {
+	const auto input = SineWave<float, TIME_DOMAIN>(8000, sampleRate, 10000.0);
+	const auto filter = DesignFilter<float, TIME_DOMAIN>(127, Fir.Lowpass.Windowed.Cutoff(0.05f).Window(windows::blackman));
+	DownConverter<float> converter(sampleRate, 10000.0, filter, 16);
+	Signal<std::complex<float>> output(converter.max_output_size(input.size()));
+	const size_t written = converter.process(output, input);
+	const auto settled = AsConstView(output).subsignal(16, written - 16);
+	// The real tone splits into two halves, only the one at the center frequency passes.
+	REQUIRE(Mean(Abs(settled)) == Approx(0.5f).epsilon(0.01f));
+	REQUIRE(Max(Abs(settled)) - Min(Abs(settled)) < 0.01f);
+}
@@ -0,0 +1,88 @@
+#include "../TestUtils.hpp"
+
+#include <dspbb/Filtering/MultistageResampler.hpp>
+#include <dspbb/Utility/Numbers.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+static double SineError(const Rational<int64_t>& sampleRates, double frequency, size_t blockSize) {
+	Signal<double> signal(12000);
+	for (size_t i = 0; i < signal.size(); ++i) {
+		signal[i] = std::sin(2.0 * pi_v<double> * frequency * double(i));
+	}
+	MultistageResampler<double> resampler{ sampleRates };
+	const auto result = StreamBlocks(resampler, signal, blockSize);
+
+	const double outputFrequency = frequency * double(sampleRates);
+	const double delay = resampler.delay();
+	double maxError = 0.0;
+	for (size_t i = size_t(delay) + 100; i < result.size() - 100; ++i) {
+		const double expected = std::sin(2.0 * pi_v<double> * outputFrequency * (double(i) - delay));
+		maxError = std::max(maxError, std::abs(result[i] - expected));
+	}
+	return maxError;
+}
+
+
+TEST_CASE("Multistage plan decimation", "[MultistageResampler]") {
+	const auto stages = PlanResampleStages({ 48000, 8000 });
+	REQUIRE(stages.size() == 3);
+	REQUIRE(stages[0].sampleRates == Rational<int64_t>{ 2, 1 });
+	REQUIRE(stages[1].sampleRates == Rational<int64_t>{ 2, 1 });
+	REQUIRE(stages[2].sampleRates == Rational<int64_t>{ 3, 2 });
+	REQUIRE(stages[2].numPhases == 2);
+}
+
+TEST_CASE("Multistage plan interpolation", "[MultistageResampler]") {
+	const auto stages = PlanResampleStages({ 44100, 96000 });
+	REQUIRE(stages.size() == 2);
+	REQUIRE(stages[0].sampleRates == Rational<int64_t>{ 147, 160 });
+	REQUIRE(stages[0].numPhases == 160);
+	REQUIRE(stages[1].sampleRates == Rational<int64_t>{ 1, 2 });
+}
+
+TEST_CASE("Multistage plan integer ratio", "[MultistageResampler]") {
+	const auto stages = PlanResampleStages({ 1, 4 });
+	REQUIRE(stages.size() == 2);
+	REQUIRE(stages[0].sampleRates == Rational<int64_t>{ 1, 2 });
+	REQUIRE(stages[1].sampleRates == Rational<int64_t>{ 1, 2 });
+}
+
+TEST_CASE("Multistage plan unit ratio", "[MultistageResampler]") {
+	const auto stages = PlanResampleStages({ 1, 1 });
+	REQUIRE(stages.size() == 1);
+	REQUIRE(stages[0].sampleRates == Rational<int64_t>{ 1, 1 });
+}
+
+TEST_CASE("Multistage plan is cheaper than single stage", "[MultistageResampler]") {
+	for (const auto& sampleRates : { Rational<int64_t>{ 48000, 8000 }, Rational<int64_t>{ 44100, 96000 }, Rational<int64_t>{ 96000, 11025 } }) {
+		const double passbandEdge = 0.9 * std::min(1.0, 1.0 / double(sampleRates)) / 2.0;
+		const auto single = impl::DesignResampleStage(sampleRates, { 1, 1 }, passbandEdge, 256);
+		const auto multi = PlanResampleStages(sampleRates);
+		REQUIRE(ResampleCost(multi) < 0.7 * ResampleCost({ single }));
+	}
+}
+
+TEST_CASE("Multistage resampler decimation accuracy", "[MultistageResampler]") {
+	REQUIRE(SineError({ 48000, 8000 }, 0.05, 1000) < 2e-3);
+}
+
+TEST_CASE("Multistage resampler interpolation accuracy", "[MultistageResampler]") {
+	REQUIRE(SineError({ 44100, 96000 }, 0.1, 441) < 2e-3);
+}
+
+TEST_CASE("Multistage resampler block size invariance", "[MultistageResampler]") {
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(3000);
+	MultistageResampler<double> resampler{ { 48000, 8000 } };
+	const auto whole = StreamBlocks(resampler, signal, signal.size());
+	resampler.reset();
+	const auto blocked = StreamBlocks(resampler, signal, 77);
+	REQUIRE(whole.size() == blocked.size());
+	REQUIRE(Max(Abs(whole - blocked)) < 1e-12);
+}
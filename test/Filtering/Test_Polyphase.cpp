@@ -48,3 +48,35 @@ TEST_CASE("Polyphase reverse", "[Polyphase]") {
 	REQUIRE(view[1][0] == 2 * 3);
 	REQUIRE(view[1][1] == 2 * 1);
 }
+
+TEST_CASE("Polyphase aligned layout", "[Polyphase]") {
+	const Signal<float> filter = { 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2 };
+	const auto view = PolyphaseDecompose(filter, 4);
+	const AlignedPolyphaseFilter aligned{ view };
+	constexpr size_t vectorWidth = decltype(aligned)::vector_width;
+	REQUIRE(aligned.num_phases() == 4);
+	REQUIRE(aligned.size_original() == filter.size());
+	REQUIRE(aligned.size_per_phase() % vectorWidth == 0);
+	REQUIRE(aligned.size_per_phase() >= view.size_per_phase());
+	for (size_t i = 0; i < 4; ++i) {
+		const auto phase = aligned[i];
+		REQUIRE(reinterpret_cast<std::uintptr_t>(phase.data()) % (vectorWidth * sizeof(float)) == 0);
+		const size_t padding = phase.size() - view[i].size();
+		REQUIRE(std::all_of(phase.begin(), phase.begin() + padding, [](float c) { return c == 0.0f; }));
+		REQUIRE(std::equal(view[i].begin(), view[i].end(), phase.begin() + padding));
+	}
+	if (aligned.num_phases() > 1) {
+		REQUIRE(aligned[1].data() == aligned[0].data() + aligned.size_per_phase());
+	}
+}
+
+TEST_CASE("Polyphase aligned copy", "[Polyphase]") {
+	const Signal<double> filter = { 1, 2, 3, 4, 5, 6, 7 };
+	const AlignedPolyphaseFilter original{ PolyphaseDecompose(filter, 3) };
+	const auto copy = original;
+	constexpr size_t vectorWidth = decltype(copy)::vector_width;
+	for (size_t i = 0; i < 3; ++i) {
+		REQUIRE(reinterpret_cast<std::uintptr_t>(copy[i].data()) % (vectorWidth * sizeof(double)) == 0);
+		REQUIRE(std::equal(original[i].begin(), original[i].end(), copy[i].begin()));
+	}
+}
@@ -57,6 +57,36 @@ TEST_CASE("Interpolation full", "[Interpolation]") {
 	}
 }
 
+TEST_CASE("Interpolation block kernel", "[Interpolation]") {
+	const auto signal = RandomSignal<float, TIME_DOMAIN>(300);
+	for (const size_t interpRate : { 2, 3, 4, 6, 8 }) {
+		for (const size_t filterSize : { interpRate * 8 - 1, interpRate * 8 + 1 }) {
+			const auto filter = DesignFilter<float, TIME_DOMAIN>(filterSize, Fir.Lowpass.Windowed.Cutoff(1.0f / interpRate));
+			const auto polyphase = PolyphaseDecompose(filter, interpRate);
+			const auto length = ConvolutionLength(signal.size() * interpRate, filter.size(), CONV_FULL);
+			// Offsets that do not fall on block boundaries.
+			for (const size_t offset : { size_t(0), size_t(1), interpRate * 20 + 1 }) {
+				const auto reference = InterpolateRefImpl(signal, filter, interpRate, offset, length - offset - 1);
+				const auto answer = Interpolate(signal, polyphase, offset, length - offset - 1);
+				INFO("rate=" << interpRate << " filterSize=" << filterSize << " offset=" << offset);
+				REQUIRE(Max(Abs(reference - answer)) < 1e-6f);
+			}
+		}
+	}
+}
+
+TEST_CASE("Interpolation block kernel complex", "[Interpolation]") {
+	const auto signal = RandomSignal<std::complex<float>, TIME_DOMAIN>(100);
+	const auto filter = DesignFilter<float, TIME_DOMAIN>(31, Fir.Lowpass.Windowed.Cutoff(0.25f));
+	const auto polyphase = PolyphaseDecompose(filter, 4);
+	const auto length = ConvolutionLength(signal.size() * 4, filter.size(), CONV_FULL);
+	const auto answer = Interpolate(signal, polyphase, 0, length);
+	const auto real = Interpolate(Real(signal), polyphase, 0, length);
+	const auto imag = Interpolate(Imag(signal), polyphase, 0, length);
+	REQUIRE(Max(Abs(Real(answer) - real)) < 1e-6f);
+	REQUIRE(Max(Abs(Imag(answer) - imag)) < 1e-6f);
+}
+
 TEST_CASE("Interpolation central", "[Interpolation]") {
 	constexpr int interpRate = 5;
 	constexpr int signalSize = 1024;
@@ -575,4 +605,157 @@ TEST_CASE("Resampling central/full", "[Interpolation]") {
 		REQUIRE(std::abs(result[0]) < 1e-4f);
 		REQUIRE(Max(result - reversed) < 2 / 2000.f);
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("Resampling schedule period", "[Interpolation]") {
+	const ResampleSchedule<double> schedule{ 6, { 14, 8 }, { 0, 1 } };
+	REQUIRE(schedule.period() == 4);
+	REQUIRE(schedule.input_step() == 7);
+	REQUIRE(schedule.num_phases() == 6);
+	for (size_t i = 0; i < schedule.period(); ++i) {
+		const auto [first, second] = impl::InputIndex2Sample(Rational<int64_t>{ 7 * int64_t(i), 4 }, 6);
+		REQUIRE(schedule[i].firstIndex == first.inputIndex);
+		REQUIRE(schedule[i].secondIndex == second.inputIndex);
+		REQUIRE(schedule[i].firstPhase == first.phaseIndex);
+		REQUIRE(schedule[i].secondPhase == second.phaseIndex);
+		REQUIRE(schedule[i].firstWeight + schedule[i].secondWeight == Approx(1.0));
+	}
+}
+
+TEST_CASE("Resampling schedule not interpolated", "[Interpolation]") {
+	const ResampleSchedule<float> interpolated{ 4, { 3, 7 }, { 0, 1 } };
+	const ResampleSchedule<float> exact{ 4, { 3, 4 }, { 0, 1 } };
+	REQUIRE(interpolated.interpolated());
+	REQUIRE(!exact.interpolated());
+}
+
+TEST_CASE("Resampling schedule matches rational", "[Interpolation]") {
+	constexpr int64_t inputRate = 147;
+	constexpr int64_t outputRate = 160;
+	constexpr size_t numPhases = 8;
+	constexpr size_t filterSize = 255;
+	constexpr size_t blockSize = 50;
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(600);
+	const auto filter = DesignFilter<double, TIME_DOMAIN>(filterSize, Fir.Lowpass.Windowed.Cutoff(ResampleFilterCutoff({ inputRate, outputRate }, numPhases)));
+	const auto polyphase = PolyphaseDecompose(filter, numPhases);
+	const size_t length = floor(ResampleLength(signal.size(), filterSize, numPhases, { inputRate, outputRate }, CONV_FULL));
+	const size_t blockedLength = length / blockSize * blockSize;
+
+	// Blocks shorter than the period go through the rational path.
+	Signal<double> expected(blockedLength);
+	for (size_t i = 0; i < blockedLength; i += blockSize) {
+		Resample(AsView(expected).subsignal(i, blockSize), signal, polyphase, { inputRate, outputRate }, Rational<int64_t>{ int64_t(i), 1 });
+	}
+
+	const ResampleSchedule<double> schedule{ numPhases, { inputRate, outputRate } };
+	Signal<double> result(blockedLength);
+	const size_t next = Resample(result, signal, polyphase, schedule);
+	REQUIRE(next == blockedLength);
+	REQUIRE(Max(Abs(result - expected)) < 1e-9);
+
+	Signal<double> continued(blockedLength);
+	size_t position = 0;
+	position = Resample(AsView(continued).subsignal(0, 333), signal, polyphase, schedule, position);
+	position = Resample(AsView(continued).subsignal(333), signal, polyphase, schedule, position);
+	REQUIRE(position == blockedLength);
+	REQUIRE(Max(Abs(continued - expected)) < 1e-9);
+}
+
+TEST_CASE("Interpolation aligned polyphase", "[Interpolation]") {
+	constexpr size_t numPhases = 5;
+	constexpr size_t filterSize = 83;
+	const auto signal = RandomSignal<float, TIME_DOMAIN>(120);
+	const auto filter = DesignFilter<float, TIME_DOMAIN>(filterSize, Fir.Lowpass.Windowed.Cutoff(InterpolFilterCutoff(numPhases)));
+	const auto polyphase = PolyphaseDecompose(filter, numPhases);
+	const AlignedPolyphaseFilter aligned{ polyphase };
+	const size_t length = InterpolLength(signal.size(), filterSize, numPhases, CONV_FULL);
+
+	const auto expected = Interpolate(signal, polyphase, 0, length);
+	Signal<float> result(length);
+	const auto suspensionPoint = Interpolate(result, signal, aligned, 0);
+	REQUIRE(Max(Abs(result - expected)) < 1e-5f);
+
+	Signal<float> expectedPartial(200);
+	Signal<float> resultPartial(200);
+	const auto expectedSuspension = Interpolate(expectedPartial, signal, polyphase, 37);
+	const auto resultSuspension = Interpolate(resultPartial, signal, aligned, 37);
+	REQUIRE(Max(Abs(resultPartial - expectedPartial)) < 1e-5f);
+	REQUIRE(resultSuspension.firstInputSample == expectedSuspension.firstInputSample);
+	REQUIRE(resultSuspension.startPoint == expectedSuspension.startPoint);
+	REQUIRE(suspensionPoint.firstInputSample > 0);
+}
+
+TEST_CASE("Resampling aligned polyphase", "[Interpolation]") {
+	constexpr size_t numPhases = 8;
+	constexpr size_t filterSize = 201;
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(500);
+	for (const auto& sampleRates : { Rational<int64_t>{ 147, 160 }, Rational<int64_t>{ 4, 1 }, Rational<int64_t>{ 5, 3 } }) {
+		const auto filter = DesignFilter<double, TIME_DOMAIN>(filterSize, Fir.Lowpass.Windowed.Cutoff(ResampleFilterCutoff(sampleRates, numPhases)));
+		const auto polyphase = PolyphaseDecompose(filter, numPhases);
+		const AlignedPolyphaseFilter aligned{ polyphase };
+		const size_t length = floor(ResampleLength(signal.size(), filterSize, numPhases, sampleRates, CONV_FULL));
+
+		Signal<double> expected(length);
+		Signal<double> result(length);
+		Resample(expected, signal, polyphase, sampleRates);
+		Resample(result, signal, aligned, sampleRates);
+		REQUIRE(Max(Abs(result - expected)) < 1e-9);
+
+		const auto expectedSuspension = Resample(AsView(expected).subsignal(0, length / 2), signal, polyphase, sampleRates, { 3, 2 });
+		const auto resultSuspension = Resample(AsView(result).subsignal(0, length / 2), signal, aligned, sampleRates, { 3, 2 });
+		REQUIRE(Max(Abs(result - expected)) < 1e-9);
+		REQUIRE(resultSuspension.firstInputSample == expectedSuspension.firstInputSample);
+		REQUIRE(resultSuspension.startPoint == expectedSuspension.startPoint);
+	}
+}
+
+TEST_CASE("Interpolation multithreaded", "[Interpolation]") {
+	constexpr size_t numPhases = 4;
+	constexpr size_t filterSize = 63;
+	const auto signal = RandomSignal<float, TIME_DOMAIN>(1000);
+	const auto filter = DesignFilter<float, TIME_DOMAIN>(filterSize, Fir.Lowpass.Windowed.Cutoff(InterpolFilterCutoff(numPhases)));
+	const auto polyphase = PolyphaseDecompose(filter, numPhases);
+	const AlignedPolyphaseFilter aligned{ polyphase };
+	const size_t length = InterpolLength(signal.size(), filterSize, numPhases, CONV_FULL) - 20;
+
+	Signal<float> expected(length);
+	const auto expectedSuspension = Interpolate(expected, signal, polyphase, 20);
+	for (size_t numThreads : { 1, 3, 8 }) {
+		Signal<float> result(length);
+		const auto suspension = Interpolate(result, signal, polyphase, 20, numThreads);
+		REQUIRE(Max(Abs(result - expected)) == 0.0f);
+		REQUIRE(suspension.firstInputSample == expectedSuspension.firstInputSample);
+		REQUIRE(suspension.startPoint == expectedSuspension.startPoint);
+
+		Signal<float> resultAligned(length);
+		Interpolate(resultAligned, signal, aligned, 20, numThreads);
+		REQUIRE(Max(Abs(resultAligned - expected)) < 1e-5f);
+	}
+}
+
+TEST_CASE("Resampling multithreaded", "[Interpolation]") {
+	constexpr size_t numPhases = 8;
+	constexpr size_t filterSize = 201;
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(2000);
+	for (const auto& sampleRates : { Rational<int64_t>{ 147, 160 }, Rational<int64_t>{ 3, 1 } }) {
+		const auto filter = DesignFilter<double, TIME_DOMAIN>(filterSize, Fir.Lowpass.Windowed.Cutoff(ResampleFilterCutoff(sampleRates, numPhases)));
+		const auto polyphase = PolyphaseDecompose(filter, numPhases);
+		const AlignedPolyphaseFilter aligned{ polyphase };
+		const Rational<int64_t> startPoint = { 5, 2 };
+		const size_t length = floor(ResampleLength(signal.size(), filterSize, numPhases, sampleRates, CONV_FULL) - startPoint);
+
+		Signal<double> expected(length);
+		const auto expectedSuspension = Resample(expected, signal, polyphase, sampleRates, startPoint);
+		for (size_t numThreads : { 1, 4, 7 }) {
+			Signal<double> result(length);
+			const auto suspension = Resample(result, signal, polyphase, sampleRates, startPoint, numThreads);
+			REQUIRE(Max(Abs(result - expected)) < 1e-9);
+			REQUIRE(suspension.firstInputSample == expectedSuspension.firstInputSample);
+			REQUIRE(suspension.startPoint == expectedSuspension.startPoint);
+
+			Signal<double> resultAligned(length);
+			Resample(resultAligned, signal, aligned, sampleRates, startPoint, numThreads);
+			REQUIRE(Max(Abs(resultAligned - expected)) < 1e-9);
+		}
+	}
+}
@@ -0,0 +1,69 @@
+#include "../TestUtils.hpp"
+
+#include <dspbb/Filtering/StreamingResampler.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+TEST_CASE("Streaming resampler matches whole signal", "[StreamingResampler]") {
+	constexpr size_t numPhases = 8;
+	constexpr size_t filterSize = 127;
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(1000);
+	for (const auto& sampleRates : { Rational<int64_t>{ 147, 160 }, Rational<int64_t>{ 3, 1 }, Rational<int64_t>{ 1, 4 }, Rational<int64_t>{ 7, 3 } }) {
+		const auto filter = DesignFilter<double, TIME_DOMAIN>(filterSize, Fir.Lowpass.Windowed.Cutoff(ResampleFilterCutoff(sampleRates, numPhases)));
+		const auto polyphase = PolyphaseDecompose(filter, numPhases);
+		const size_t length = floor(ResampleLength(signal.size(), filterSize, numPhases, sampleRates, CONV_FULL));
+		Signal<double> expected(length);
+		Resample(expected, signal, polyphase, sampleRates);
+
+		StreamingResampler<double> resampler{ polyphase, sampleRates };
+		const auto result = StreamBlocks(resampler, signal, { 1, 17, 64, 3, 250 });
+		REQUIRE(result.size() > signal.size() * sampleRates.Denominator() / sampleRates.Numerator() - 2);
+		REQUIRE(result.size() <= expected.size());
+		REQUIRE(Max(Abs(result - AsConstView(expected).subsignal(0, result.size()))) < 1e-9);
+	}
+}
+
+TEST_CASE("Streaming resampler small output", "[StreamingResampler]") {
+	constexpr size_t numPhases = 4;
+	const Rational<int64_t> sampleRates = { 2, 5 };
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(400);
+	const auto filter = DesignFilter<double, TIME_DOMAIN>(63, Fir.Lowpass.Windowed.Cutoff(ResampleFilterCutoff(sampleRates, numPhases)));
+	const auto polyphase = PolyphaseDecompose(filter, numPhases);
+
+	StreamingResampler<double> reference{ polyphase, sampleRates };
+	const auto expected = StreamBlocks(reference, signal, { 400 });
+
+	// Outputs that don't fit are delivered by later calls.
+	StreamingResampler<double> resampler{ polyphase, sampleRates };
+	Signal<double> result;
+	Signal<double> output(3);
+	for (size_t i = 0; i < signal.size(); i += 20) {
+		const size_t produced = resampler.process(output, AsConstView(signal).subsignal(i, 20));
+		result.insert(result.end(), output.begin(), output.begin() + produced);
+	}
+	for (size_t produced = resampler.process(output, Signal<double>{}); produced > 0; produced = resampler.process(output, Signal<double>{})) {
+		result.insert(result.end(), output.begin(), output.begin() + produced);
+	}
+	REQUIRE(result.size() == expected.size());
+	REQUIRE(Max(Abs(result - expected)) < 1e-12);
+}
+
+TEST_CASE("Streaming resampler reset", "[StreamingResampler]") {
+	constexpr size_t numPhases = 6;
+	const Rational<int64_t> sampleRates = { 5, 6 };
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(300);
+	const auto filter = DesignFilter<double, TIME_DOMAIN>(95, Fir.Lowpass.Windowed.Cutoff(ResampleFilterCutoff(sampleRates, numPhases)));
+
+	StreamingResampler<double> resampler{ PolyphaseDecompose(filter, numPhases), sampleRates };
+	const auto first = StreamBlocks(resampler, signal, { 33 });
+	resampler.reset();
+	const auto second = StreamBlocks(resampler, signal, { 33 });
+	REQUIRE(first.size() == second.size());
+	REQUIRE(Max(Abs(first - second)) == 0.0);
+}
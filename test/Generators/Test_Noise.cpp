@@ -0,0 +1,161 @@
+#include <dspbb/Generators/Noise.hpp>
+#include <dspbb/Math/FFT.hpp>
+#include <dspbb/Math/Statistics.hpp>
+#include <dspbb/Primitives/Signal.hpp>
+#include <dspbb/Primitives/SignalView.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+constexpr uint64_t seed = 0x0123456789ABCDEF;
+
+
+// The power between two normalized frequencies in dB.
+template <class T>
+double BandPower(const Signal<T>& signal, double low, double high) {
+	const auto spectrum = Fft(signal, FFT_HALF);
+	const size_t first = size_t(low * double(signal.size()));
+	const size_t last = size_t(high * double(signal.size()));
+	double power = 0.0;
+	for (size_t bin = first; bin < last; ++bin) {
+		power += std::norm(spectrum[bin]);
+	}
+	return 10.0 * std::log10(power);
+}
+
+
+TEST_CASE("Philox known answers", "[Noise]") {
+	using Words = std::array<uint32_t, 4>;
+	REQUIRE(impl::Philox4x32({ 0, 0, 0, 0 }, { 0, 0 }) == Words{ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 });
+	REQUIRE(impl::Philox4x32({ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff })
+			== Words{ 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd });
+	REQUIRE(impl::Philox4x32({ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 })
+			== Words{ 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 });
+}
+
+
+TEST_CASE("Uniform noise range and moments", "[Noise]") {
+	UniformNoise<float> noise(seed, 2.0f, 5.0f);
+	Signal<float> signal(100000);
+	noise.process(signal);
+	REQUIRE(Min(signal) >= 2.0f);
+	REQUIRE(Max(signal) < 5.0f);
+	REQUIRE(Mean(signal) == Approx(3.5f).margin(0.02f));
+	REQUIRE(Variance(signal) == Approx(0.75f).epsilon(0.02f));
+}
+
+
+TEST_CASE("Uniform noise double", "[Noise]") {
+	UniformNoise<double> noise(seed, 0.0, 1.0);
+	Signal<double> signal(100000);
+	noise.process(signal);
+	REQUIRE(Min(signal) >= 0.0);
+	REQUIRE(Max(signal) < 1.0);
+	REQUIRE(Mean(signal) == Approx(0.5).margin(0.01));
+	REQUIRE(Variance(signal) == Approx(1.0 / 12.0).epsilon(0.02));
+}
+
+
+TEST_CASE("Noise is reproducible", "[Noise]") {
+	UniformNoise<float> noise1(seed);
+	UniformNoise<float> noise2(seed);
+	UniformNoise<float> noise3(seed + 1);
+	Signal<float> signal1(1000), signal2(1000), signal3(1000);
+	noise1.process(signal1);
+	noise2.process(signal2);
+	noise3.process(signal3);
+	REQUIRE(std::equal(signal1.begin(), signal1.end(), signal2.begin()));
+	REQUIRE(!std::equal(signal1.begin(), signal1.end(), signal3.begin()));
+
+	noise1.reset();
+	noise1.process(signal2);
+	REQUIRE(std::equal(signal1.begin(), signal1.end(), signal2.begin()));
+}
+
+
+TEST_CASE("Noise blocks continue the stream", "[Noise]") {
+	GaussianNoise<double> whole(seed);
+	GaussianNoise<double> blocks(seed);
+	Signal<double> expected(1000);
+	Signal<double> signal(1000);
+	whole.process(expected);
+	size_t first = 0;
+	for (size_t count = 1; first < signal.size(); count = count * 3 % 97 + 1) {
+		const size_t size = std::min(count, signal.size() - first);
+		blocks.process(AsView(signal).subsignal(first, size));
+		first += size;
+	}
+	REQUIRE(std::equal(signal.begin(), signal.end(), expected.begin()));
+	REQUIRE(blocks.position() == 1000);
+}
+
+
+TEST_CASE("Noise seek", "[Noise]") {
+	UniformNoise<float> noise(seed);
+	Signal<float> expected(1000);
+	noise.process(expected);
+
+	Signal<float> signal(333);
+	noise.seek(517);
+	noise.process(signal);
+	REQUIRE(std::equal(signal.begin(), signal.end(), expected.begin() + 517));
+	REQUIRE(noise.position() == 850);
+}
+
+
+TEST_CASE("Noise multithreaded", "[Noise]") {
+	GaussianNoise<float> noise(seed);
+	Signal<float> expected(10007);
+	Signal<float> signal(10007);
+	noise.process(expected);
+	noise.reset();
+	noise.process(signal, 4);
+	REQUIRE(std::equal(signal.begin(), signal.end(), expected.begin()));
+}
+
+
+TEST_CASE("Gaussian noise moments", "[Noise]") {
+	GaussianNoise<float> noiseFloat(seed, 1.0f, 2.0f);
+	GaussianNoise<double> noiseDouble(seed, 1.0, 2.0);
+	Signal<float> signalFloat(100000);
+	Signal<double> signalDouble(100000);
+	noiseFloat.process(signalFloat);
+	noiseDouble.process(signalDouble);
+	REQUIRE(Mean(signalFloat) == Approx(1.0f).margin(0.03f));
+	REQUIRE(StandardDeviation(signalFloat) == Approx(2.0f).epsilon(0.02f));
+	REQUIRE(Kurtosis(signalFloat) == Approx(3.0f).epsilon(0.05f));
+	REQUIRE(Mean(signalDouble) == Approx(1.0).margin(0.03));
+	REQUIRE(StandardDeviation(signalDouble) == Approx(2.0).epsilon(0.02));
+	REQUIRE(Kurtosis(signalDouble) == Approx(3.0).epsilon(0.05));
+}
+
+
+TEST_CASE("Pink noise spectrum", "[Noise]") {
+	PinkNoise<double> noise(seed);
+	Signal<double> signal(65536);
+	noise.process(signal);
+	REQUIRE(StandardDeviation(signal) == Approx(1.0).epsilon(0.1));
+	// Equal power in every octave.
+	const double octave1 = BandPower(signal, 0.005, 0.01);
+	const double octave3 = BandPower(signal, 0.02, 0.04);
+	const double octave5 = BandPower(signal, 0.08, 0.16);
+	REQUIRE(octave1 == Approx(octave3).margin(1.0));
+	REQUIRE(octave3 == Approx(octave5).margin(1.0));
+}
+
+
+TEST_CASE("Brown noise spectrum", "[Noise]") {
+	BrownNoise<double> noise(seed);
+	Signal<double> signal(65536);
+	noise.process(signal);
+	REQUIRE(StandardDeviation(signal) == Approx(1.0).epsilon(0.15));
+	// 3 dB less power in every next octave.
+	const double octave1 = BandPower(signal, 0.01, 0.02);
+	const double octave3 = BandPower(signal, 0.04, 0.08);
+	REQUIRE(octave1 - octave3 == Approx(6.0).margin(1.0));
+}
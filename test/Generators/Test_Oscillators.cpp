@@ -0,0 +1,190 @@
+#include <dspbb/Filtering/Windowing.hpp>
+#include <dspbb/Generators/Oscillators.hpp>
+#include <dspbb/Generators/Waveforms.hpp>
+#include <dspbb/Math/FFT.hpp>
+#include <dspbb/Math/Functions.hpp>
+#include <dspbb/Math/Statistics.hpp>
+#include <dspbb/Primitives/Signal.hpp>
+#include <dspbb/Primitives/SignalView.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+constexpr uint64_t sampleRate = 44100;
+constexpr double frequency = 89.0;
+
+
+// Generates the signal in blocks of varying sizes to check that the phase carries over.
+template <class T, class Shape>
+Signal<T> GenerateBlocks(Oscillator<T, Shape>& oscillator, size_t length) {
+	Signal<T> signal(length);
+	size_t first = 0;
+	for (size_t count = 1; first < length; count = count * 3 % 97 + 1) {
+		const size_t size = std::min(count, length - first);
+		oscillator.process(AsView(signal).subsignal(first, size));
+		first += size;
+	}
+	return signal;
+}
+
+// The energy away from the harmonics relative to the total energy in dB.
+template <class Shape>
+double AliasLevel(Shape shape, double frequency) {
+	constexpr size_t length = 8192;
+	Oscillator<double, Shape> oscillator(sampleRate, frequency, 0.0, shape);
+	Signal<double> signal(length);
+	oscillator.process(signal);
+	Signal<double> window(length);
+	windows::blackman(window);
+	signal *= window;
+
+	const auto spectrum = Fft(signal, FFT_HALF);
+	const double binWidth = double(sampleRate) / double(length);
+	double alias = 0.0;
+	double total = 0.0;
+	for (size_t bin = 0; bin < spectrum.size(); ++bin) {
+		const double binFrequency = double(bin) * binWidth;
+		const double harmonic = std::round(binFrequency / frequency) * frequency;
+		const double power = std::norm(spectrum[bin]);
+		total += power;
+		alias += std::abs(binFrequency - harmonic) > 4.0 * binWidth ? power : 0.0;
+	}
+	return 10.0 * std::log10(alias / total);
+}
+
+
+TEST_CASE("Sin cycles accuracy", "[Oscillators]") {
+	for (double u = 0.0; u < 6.0; u += 0.00123) {
+		REQUIRE(impl::SinCycles(u) == Approx(std::sin(2.0 * pi_v<double> * u)).margin(1e-14));
+		REQUIRE(impl::SinCycles(float(u)) == Approx(std::sin(2.0 * pi_v<double> * float(u))).margin(4e-7));
+	}
+}
+
+TEST_CASE("Sine oscillator matches sine wave", "[Oscillators]") {
+	SineOscillator<double> oscillator(sampleRate, frequency, 0.5);
+	const auto result = GenerateBlocks(oscillator, 4410);
+	const auto expected = SineWave<double, TIME_DOMAIN>(4410, sampleRate, frequency, 0.5);
+	REQUIRE(Max(Abs(result - expected)) < 1e-9);
+	REQUIRE(oscillator.phase() == Approx(std::fmod(0.5 + 2.0 * pi_v<double> * frequency * 0.1, 2.0 * pi_v<double>)));
+}
+
+TEST_CASE("Sine oscillator float", "[Oscillators]") {
+	SineOscillator<float> oscillator(sampleRate, frequency, 0.5);
+	const auto result = GenerateBlocks(oscillator, 4410);
+	const auto expected = SineWave<float, TIME_DOMAIN>(4410, sampleRate, frequency, 0.5);
+	REQUIRE(Max(Abs(result - expected)) < 1e-5f);
+}
+
+TEST_CASE("Complex sine oscillator", "[Oscillators]") {
+	SineOscillator<std::complex<float>> oscillator(sampleRate, -frequency, 0.5);
+	const auto result = GenerateBlocks(oscillator, 4410);
+	const auto sine = SineWave<float, TIME_DOMAIN>(4410, sampleRate, -frequency, 0.5);
+	const auto cosine = SineWave<float, TIME_DOMAIN>(4410, sampleRate, -frequency, 0.5 + pi_v<double> / 2.0);
+	REQUIRE(Max(Abs(Imag(result) - sine)) < 1e-5f);
+	REQUIRE(Max(Abs(Real(result) - cosine)) < 1e-5f);
+}
+
+TEST_CASE("Oscillator long run keeps phase", "[Oscillators]") {
+	SineOscillator<float> oscillator(sampleRate, 1000.0);
+	Signal<float> block(sampleRate);
+	for (int second = 0; second < 100; ++second) {
+		oscillator.process(block);
+	}
+	REQUIRE(std::remainder(oscillator.phase(), 2.0 * pi_v<double>) == Approx(0.0).margin(1e-9));
+	REQUIRE(block[0] == Approx(0.0f).margin(1e-6f));
+	REQUIRE(block[11] == Approx(std::sin(2.0 * pi_v<double> * 1000.0 * 11.0 / double(sampleRate))).margin(1e-6f));
+}
+
+TEST_CASE("Oscillator frequency change is continuous", "[Oscillators]") {
+	SineOscillator<double> oscillator(sampleRate, 1000.0);
+	Signal<double> first(100);
+	Signal<double> second(100);
+	oscillator.process(first);
+	const double phase = oscillator.phase();
+	oscillator.set_frequency(2000.0);
+	REQUIRE(oscillator.frequency() == Approx(2000.0));
+	oscillator.process(second);
+	REQUIRE(second[0] == Approx(std::sin(phase)));
+	REQUIRE(second[1] == Approx(std::sin(phase + 2.0 * pi_v<double> * 2000.0 / double(sampleRate))));
+
+	oscillator.reset();
+	oscillator.process(second);
+	REQUIRE(Max(Abs(second - first)) < 1e-12);
+}
+
+TEST_CASE("Sawtooth oscillator matches sawtooth wave", "[Oscillators]") {
+	for (double tilt : { 1.0, 0.5, 0.3, 0.0 }) {
+		SawtoothOscillator<float> oscillator(sampleRate, frequency, 0.2, waves::Sawtooth{ tilt });
+		const auto result = GenerateBlocks(oscillator, 4410);
+		const auto expected = SawtoothWave<float, TIME_DOMAIN>(4410, sampleRate, frequency, 0.2, tilt);
+		REQUIRE(Max(Abs(result - expected)) < 1e-5f);
+	}
+}
+
+TEST_CASE("PWM oscillator matches PWM wave", "[Oscillators]") {
+	for (double fill : { 1.0, 0.5, 0.3, 0.0 }) {
+		PwmOscillator<float> oscillator(sampleRate, frequency, 0.2, waves::Pwm{ fill });
+		const auto result = GenerateBlocks(oscillator, 4410);
+		const auto expected = PwmWave<float, TIME_DOMAIN>(4410, sampleRate, frequency, 0.2, fill);
+		REQUIRE(Max(Abs(result - expected)) == 0.0f);
+	}
+}
+
+TEST_CASE("Square oscillator matches square wave", "[Oscillators]") {
+	SquareOscillator<double> oscillator(sampleRate, frequency, 0.2);
+	const auto result = GenerateBlocks(oscillator, 4410);
+	const auto expected = SquareWave<double, TIME_DOMAIN>(4410, sampleRate, frequency, 0.2);
+	REQUIRE(Max(Abs(result - expected)) == 0.0);
+}
+
+TEST_CASE("Sweeping oscillator matches chirp", "[Oscillators]") {
+	constexpr size_t length = 8820;
+	constexpr double startFrequency = 200.0;
+	constexpr double endFrequency = 3000.0;
+	const double duration = double(length) / double(sampleRate);
+
+	SineOscillator<double> oscillator(sampleRate, startFrequency, 0.3);
+	oscillator.set_sweep((endFrequency - startFrequency) / duration);
+	const auto result = GenerateBlocks(oscillator, length);
+	const auto expected = SineChirp<double, TIME_DOMAIN>(length, sampleRate, startFrequency, endFrequency, 0.3);
+	REQUIRE(Max(Abs(result - expected)) < 1e-9);
+	REQUIRE(oscillator.frequency() == Approx(endFrequency));
+}
+
+TEST_CASE("Bandlimited shapes match naive away from jumps", "[Oscillators]") {
+	const double increment = frequency / double(sampleRate);
+	for (double phase = 0.0; phase < 1.0; phase += 0.0137) {
+		const bool nearRise = phase < increment || phase > 1.0 - increment;
+		const bool nearFall = std::abs(phase - 0.3) < increment;
+		if (!nearRise) {
+			REQUIRE(waves::BandlimitedSawtooth{}(phase, increment) == Approx(waves::Sawtooth{}(phase, increment)));
+		}
+		if (!nearRise && !nearFall) {
+			REQUIRE(waves::BandlimitedPwm{ 0.3 }(phase, increment) == Approx(waves::Pwm{ 0.3 }(phase, increment)));
+		}
+	}
+	REQUIRE(waves::BandlimitedSquare{}(0.0, increment) == Approx(0.0));
+	REQUIRE(waves::BandlimitedSquare{}(0.5, increment) == Approx(0.0));
+}
+
+TEST_CASE("Bandlimited oscillators suppress aliasing", "[Oscillators]") {
+	for (double toneFrequency : { 1234.0, 3217.0, 5123.0 }) {
+		REQUIRE(AliasLevel(waves::BandlimitedSawtooth{}, toneFrequency) < AliasLevel(waves::Sawtooth{}, toneFrequency) - 12.0);
+		REQUIRE(AliasLevel(waves::BandlimitedSquare{}, toneFrequency) < AliasLevel(waves::Square{}, toneFrequency) - 12.0);
+		REQUIRE(AliasLevel(waves::BandlimitedPwm{ 0.3 }, toneFrequency) < AliasLevel(waves::Pwm{ 0.3 }, toneFrequency) - 12.0);
+	}
+}
+
+TEST_CASE("Bandlimited oscillator continues phase", "[Oscillators]") {
+	BandlimitedSquareOscillator<float> blocks(sampleRate, 3217.0, 0.4);
+	BandlimitedSquareOscillator<float> whole(sampleRate, 3217.0, 0.4);
+	const auto result = GenerateBlocks(blocks, 4410);
+	Signal<float> expected(4410);
+	whole.process(expected);
+	REQUIRE(Max(Abs(result - expected)) < 1e-4f);
+}
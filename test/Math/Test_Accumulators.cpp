@@ -0,0 +1,116 @@
+#include "../TestUtils.hpp"
+
+#include <dspbb/Math/Accumulators.hpp>
+#include <dspbb/Math/Statistics.hpp>
+#include <dspbb/Primitives/Signal.hpp>
+#include <dspbb/Primitives/SignalView.hpp>
+#include <dspbb/Utility/Parallel.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <complex>
+
+
+using namespace dspbb;
+using namespace std::complex_literals;
+using Catch::Approx;
+
+
+constexpr std::initializer_list<size_t> blockSizes = { 1, 8, 57, 69, 153, 252, 110, 109, 102 };
+
+// Feeds the accumulator in blocks of varying sizes.
+template <class Accumulator>
+void AddBlocks(Accumulator& accumulator, const Signal<double>& signal) {
+	ForEachBlock(signal.size(), blockSizes, [&](size_t first, size_t count) {
+		accumulator.add(AsConstView(signal).subsignal(first, count));
+	});
+}
+
+
+TEST_CASE("Mean accumulator", "[Accumulators]") {
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(10000) + 3.0;
+	MeanAccumulator<double> accumulator;
+	AddBlocks(accumulator, signal);
+	REQUIRE(accumulator.count() == signal.size());
+	REQUIRE(accumulator.mean() == Approx(Mean(signal)).epsilon(1e-12));
+}
+
+
+TEST_CASE("Mean accumulator complex", "[Accumulators]") {
+	const Signal<std::complex<float>> signal = { 1.0f + 2.0if, 3.0f, 5.0f - 4.0if, 7.0f };
+	MeanAccumulator<std::complex<float>> accumulator;
+	accumulator.add(AsConstView(signal).subsignal(0, 1));
+	accumulator.add(AsConstView(signal).subsignal(1, 3));
+	REQUIRE(accumulator.mean().real() == Approx(4.0f));
+	REQUIRE(accumulator.mean().imag() == Approx(-0.5f));
+}
+
+
+TEST_CASE("Variance accumulator", "[Accumulators]") {
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(10000) + 1e6;
+	VarianceAccumulator<double> accumulator;
+	AddBlocks(accumulator, signal);
+	REQUIRE(accumulator.count() == signal.size());
+	REQUIRE(accumulator.mean() == Approx(Mean(signal)).epsilon(1e-12));
+	REQUIRE(accumulator.variance() == Approx(Variance(signal)).epsilon(1e-9));
+	REQUIRE(accumulator.corrected_variance() == Approx(CorrectedVariance(signal)).epsilon(1e-9));
+	REQUIRE(accumulator.standard_deviation() == Approx(StandardDeviation(signal)).epsilon(1e-9));
+	REQUIRE(accumulator.corrected_standard_deviation() == Approx(CorrectedStandardDeviation(signal)).epsilon(1e-9));
+}
+
+
+TEST_CASE("Variance accumulator merge across threads", "[Accumulators]") {
+	const auto signal = RandomSignal<double, TIME_DOMAIN>(100000) - 5.0;
+	constexpr size_t numShards = 7;
+	std::array<VarianceAccumulator<double>, numShards> shards;
+	const size_t shardSize = (signal.size() + numShards - 1) / numShards;
+	impl::ParallelFor(numShards, numShards, [&](size_t first, size_t last) {
+		for (size_t shard = first; shard < last; ++shard) {
+			const size_t begin = shard * shardSize;
+			shards[shard].add(AsConstView(signal).subsignal(begin, std::min(shardSize, signal.size() - begin)));
+		}
+	});
+	VarianceAccumulator<double> total;
+	for (const auto& shard : shards) {
+		total.merge(shard);
+	}
+	REQUIRE(total.count() == signal.size());
+	REQUIRE(total.mean() == Approx(Mean(signal)).epsilon(1e-12));
+	REQUIRE(total.variance() == Approx(Variance(signal)).epsilon(1e-12));
+}
+
+
+TEST_CASE("Variance accumulator empty and reset", "[Accumulators]") {
+	VarianceAccumulator<float> accumulator;
+	REQUIRE(accumulator.count() == 0);
+	REQUIRE(accumulator.variance() == 0.0f);
+	accumulator.merge(VarianceAccumulator<float>{});
+	accumulator.add(Signal<float>{});
+	REQUIRE(accumulator.count() == 0);
+	accumulator.add(Signal<float>{ 2, 4, 4, 4, 5, 5, 7, 9 });
+	REQUIRE(accumulator.variance() == Approx(4.0f));
+	accumulator.reset();
+	REQUIRE(accumulator.count() == 0);
+}
+
+
+TEST_CASE("Covariance accumulator", "[Accumulators]") {
+	const auto a = RandomSignal<double, TIME_DOMAIN>(10000) + 100.0;
+	auto b = RandomSignal<double, TIME_DOMAIN>(10000) - 20.0;
+	b += 0.5 * a;
+
+	CovarianceAccumulator<double> first;
+	CovarianceAccumulator<double> second;
+	ForEachBlock(a.size(), blockSizes, [&](size_t begin, size_t count) {
+		auto& accumulator = begin < a.size() / 3 ? first : second;
+		accumulator.add(AsConstView(a).subsignal(begin, count), AsConstView(b).subsignal(begin, count));
+	});
+	first.merge(second);
+
+	REQUIRE(first.count() == a.size());
+	REQUIRE(first.first().mean() == Approx(Mean(a)).epsilon(1e-12));
+	REQUIRE(first.second().variance() == Approx(Variance(b)).epsilon(1e-9));
+	REQUIRE(first.covariance() == Approx(Covariance(a, b)).epsilon(1e-9));
+	REQUIRE(first.corrected_covariance() == Approx(CorrectedCovariance(a, b)).epsilon(1e-9));
+	REQUIRE(first.correlation() == Approx(Correlation(a, b)).epsilon(1e-9));
+}
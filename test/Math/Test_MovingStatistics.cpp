@@ -0,0 +1,206 @@
+#include "../TestUtils.hpp"
+
+#include <dspbb/Math/MovingStatistics.hpp>
+#include <dspbb/Math/Statistics.hpp>
+#include <dspbb/Primitives/Signal.hpp>
+#include <dspbb/Primitives/SignalView.hpp>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+using namespace dspbb;
+using Catch::Approx;
+
+
+constexpr size_t windowSize = 37;
+
+
+// Processes the input in blocks of varying sizes to check that the state carries over.
+template <class Operator>
+Signal<double> ProcessBlocks(Operator& op, const Signal<double>& input) {
+	Signal<double> output(input.size());
+	ForEachBlock(input.size(), { 1, 4, 13, 40, 24, 73, 26, 79 }, [&](size_t first, size_t count) {
+		op.process(AsView(output).subsignal(first, count), AsConstView(input).subsignal(first, count));
+	});
+	return output;
+}
+
+// Applies a whole-signal statistic to every window of the zero-padded input.
+template <class Func>
+Signal<double> Reference(const Signal<double>& input, Func func) {
+	Signal<double> padded(windowSize - 1, 0.0);
+	padded.append(input);
+	Signal<double> output(input.size());
+	for (size_t n = 0; n < input.size(); ++n) {
+		output[n] = func(AsConstView(padded).subsignal(n, windowSize));
+	}
+	return output;
+}
+
+template <class Func>
+void RequireApprox(const Signal<double>& output, const Signal<double>& input, Func func) {
+	const auto expected = Reference(input, func);
+	for (size_t n = 0; n < output.size(); ++n) {
+		REQUIRE(output[n] == Approx(expected[n]).margin(1e-9));
+	}
+}
+
+
+TEST_CASE("Moving sum", "[MovingStatistics]") {
+	const auto input = RandomSignal<double, TIME_DOMAIN>(1000);
+	MovingSum<double> op(windowSize);
+	const auto output = ProcessBlocks(op, input);
+	RequireApprox(output, input, [](const auto& window) { return Sum(window); });
+}
+
+
+TEST_CASE("Moving mean", "[MovingStatistics]") {
+	const auto input = RandomSignal<double, TIME_DOMAIN>(1000);
+	MovingMean<double> op(windowSize);
+	const auto output = ProcessBlocks(op, input);
+	RequireApprox(output, input, [](const auto& window) { return Mean(window); });
+}
+
+
+TEST_CASE("Moving RMS", "[MovingStatistics]") {
+	const auto input = RandomSignal<double, TIME_DOMAIN>(1000);
+	MovingRootMeanSquare<double> op(windowSize);
+	const auto output = ProcessBlocks(op, input);
+	RequireApprox(output, input, [](const auto& window) { return RootMeanSquare(window); });
+}
+
+
+TEST_CASE("Moving variance", "[MovingStatistics]") {
+	const auto input = RandomSignal<double, TIME_DOMAIN>(1000);
+	MovingVariance<double> op(windowSize);
+	const auto output = ProcessBlocks(op, input);
+	RequireApprox(output, input, [](const auto& window) { return Variance(window); });
+}
+
+
+TEST_CASE("Moving variance large mean", "[MovingStatistics]") {
+	const auto input = RandomSignal<double, TIME_DOMAIN>(100000) + 1000.0;
+	MovingVariance<double> op(windowSize);
+	Signal<double> output(input.size());
+	op.process(output, input);
+	const auto expected = Variance(AsConstView(input).subsignal(input.size() - windowSize));
+	REQUIRE(output[output.size() - 1] == Approx(expected).epsilon(1e-6));
+}
+
+
+TEST_CASE("Moving sum error stays bounded", "[MovingStatistics]") {
+	const auto input = RandomSignal<double, TIME_DOMAIN>(1000000) + 0.5;
+	MovingSum<float> op(windowSize);
+	Signal<float> inputFloat(input.begin(), input.end());
+	Signal<float> output(input.size());
+	op.process(output, inputFloat);
+	const auto expected = Sum(Signal<double>(inputFloat.end() - windowSize, inputFloat.end()));
+	REQUIRE(output[output.size() - 1] == Approx(expected).epsilon(1e-6f));
+}
+
+
+TEST_CASE("Moving max", "[MovingStatistics]") {
+	const auto input = RandomSignal<double, TIME_DOMAIN>(1000) + 0.5;
+	MovingMax<double> op(windowSize);
+	const auto output = ProcessBlocks(op, input);
+	RequireApprox(output, input, [](const auto& window) { return Max(window); });
+}
+
+
+TEST_CASE("Moving min", "[MovingStatistics]") {
+	const auto input = RandomSignal<double, TIME_DOMAIN>(1000) - 0.5;
+	MovingMin<double> op(windowSize);
+	const auto output = ProcessBlocks(op, input);
+	RequireApprox(output, input, [](const auto& window) { return Min(window); });
+}
+
+
+TEST_CASE("Moving min/max with repeated values", "[MovingStatistics]") {
+	Signal<double> input = { 3, 3, 1, 3, 2, 2, 2, 5, 5, 1, 1, 1, 1, 4, 4, 0, 2, 2, 3, 3, 3, 3, 3, 3 };
+	input *= -1.0;
+	input.append(input);
+	MovingMin<double> min(windowSize);
+	MovingMax<double> max(windowSize);
+	RequireApprox(ProcessBlocks(min, input), input, [](const auto& window) { return Min(window); });
+	RequireApprox(ProcessBlocks(max, input), input, [](const auto& window) { return Max(window); });
+}
+
+
+TEST_CASE("Moving statistics in place and reset", "[MovingStatistics]") {
+	const auto input = RandomSignal<double, TIME_DOMAIN>(200);
+	MovingVariance<double> op(windowSize);
+	Signal<double> expected(input.size());
+	op.process(expected, input);
+	op.reset();
+	auto signal = input;
+	op.process(signal, signal);
+	for (size_t n = 0; n < signal.size(); ++n) {
+		REQUIRE(signal[n] == Approx(expected[n]));
+	}
+}
+
+
+TEST_CASE("Selection network", "[MovingStatistics]") {
+	// By the 0-1 principle, a network that selects correctly for all binary inputs does so for any input.
+	for (size_t size = 1; size <= 12; ++size) {
+		for (size_t rank = 0; rank < size; ++rank) {
+			const auto network = impl::SelectionNetwork(size, rank);
+			for (size_t bits = 0; bits < (size_t(1) << size); ++bits) {
+				std::vector<int> values(size);
+				for (size_t i = 0; i < size; ++i) {
+					values[i] = int((bits >> i) & 1);
+				}
+				auto expected = values;
+				std::sort(expected.begin(), expected.end());
+				for (const auto& [a, b] : network) {
+					if (values[b] < values[a]) {
+						std::swap(values[a], values[b]);
+					}
+				}
+				REQUIRE(values[rank] == expected[rank]);
+			}
+		}
+	}
+}
+
+
+TEST_CASE("Moving percentile", "[MovingStatistics]") {
+	const auto input = RandomSignal<double, TIME_DOMAIN>(1000);
+	for (size_t size : { 1, 2, 3, 4, 9, 15, 16, 37, 101 }) {
+		for (double percentile : { 0.0, 0.3, 0.5, 1.0 }) {
+			MovingPercentile<double> op(size, percentile);
+			const auto output = ProcessBlocks(op, input);
+
+			Signal<double> padded(size - 1, 0.0);
+			padded.append(input);
+			for (size_t n = 0; n < input.size(); ++n) {
+				std::vector<double> window(padded.begin() + n, padded.begin() + n + size);
+				std::nth_element(window.begin(), window.begin() + op.rank(), window.end());
+				REQUIRE(output[n] == window[op.rank()]);
+			}
+		}
+	}
+}
+
+
+TEST_CASE("Moving median", "[MovingStatistics]") {
+	const Signal<float> input = { 5, 1, 9, 3, 3, 8, 2, 7, 100, 6 };
+	const Signal<float> expected = { 0, 1, 5, 3, 3, 3, 3, 7, 7, 7 };
+	MovingMedian<float> op(3);
+	Signal<float> output(input.size());
+	op.process(output, input);
+	REQUIRE(std::equal(expected.begin(), expected.end(), output.begin()));
+}
+
+
+TEST_CASE("Moving median large window in place and reset", "[MovingStatistics]") {
+	const auto input = RandomSignal<double, TIME_DOMAIN>(500);
+	MovingMedian<double> op(101);
+	Signal<double> expected(input.size());
+	op.process(expected, input);
+	op.reset();
+	auto signal = input;
+	op.process(signal, signal);
+	REQUIRE(std::equal(signal.begin(), signal.end(), expected.begin()));
+}
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <dspbb/Primitives/Signal.hpp>
+#include <dspbb/Primitives/SignalView.hpp>
 #include <dspbb/Utility/TypeTraits.hpp>
 
+#include <algorithm>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <complex>
+#include <initializer_list>
 #include <random>
 
 
@@ -134,4 +137,36 @@ dspbb::BasicSignal<T, Domain> RandomSignal(size_t length) {
 		}
 	}
 	return s;
-}
\ No newline at end of file
+}
+
+// Calls func(first, count) for consecutive blocks of a signal of the given length, cycling through the block sizes.
+template <class Func>
+void ForEachBlock(size_t length, std::initializer_list<size_t> blockSizes, Func func) {
+	auto blockSize = blockSizes.begin();
+	for (size_t first = 0; first < length;) {
+		const size_t count = std::min(*blockSize, length - first);
+		func(first, count);
+		first += count;
+		if (++blockSize == blockSizes.end()) {
+			blockSize = blockSizes.begin();
+		}
+	}
+}
+
+// Feeds a signal to a streaming engine block by block and concatenates the outputs.
+template <class Engine, class T>
+dspbb::Signal<T> StreamBlocks(Engine& engine, const dspbb::Signal<T>& signal, std::initializer_list<size_t> blockSizes) {
+	dspbb::Signal<T> result;
+	ForEachBlock(signal.size(), blockSizes, [&](size_t first, size_t count) {
+		dspbb::Signal<T> output(engine.max_output_size(count));
+		const size_t produced = engine.process(output, AsConstView(signal).subsignal(first, count));
+		REQUIRE(produced <= output.size());
+		result.insert(result.end(), output.begin(), output.begin() + produced);
+	});
+	return result;
+}
+
+template <class Engine, class T>
+dspbb::Signal<T> StreamBlocks(Engine& engine, const dspbb::Signal<T>& signal, size_t blockSize) {
+	return StreamBlocks(engine, signal, { blockSize });
+}
@@ -0,0 +1,33 @@
+#include <dspbb/Utility/Denormals.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <limits>
+
+using namespace dspbb;
+
+
+
+TEST_CASE("Flush denormals in scope", "[Denormals]") {
+	volatile float normal = std::numeric_limits<float>::min();
+	volatile float scale = 0.25f;
+	{
+		ScopedFlushDenormals guard;
+		const float product = normal * scale;
+#if defined(DSPBB_DENORMALS_SSE) || defined(DSPBB_DENORMALS_AARCH64)
+		REQUIRE(product == 0.0f);
+#else
+		// The guard is a no-op where the control register is not accessible, so the product stays subnormal.
+		REQUIRE(product > 0.0f);
+#endif
+	}
+	const float product = normal * scale;
+	REQUIRE(product > 0.0f);
+}
+
+TEST_CASE("Denormal offset is normal", "[Denormals]") {
+	REQUIRE(DenormalOffset<float>() > std::numeric_limits<float>::min());
+	REQUIRE(DenormalOffset<float>() < 1e-15f);
+	REQUIRE(DenormalOffset<double>() > std::numeric_limits<double>::min());
+	REQUIRE(DenormalOffset<double>() < 1e-100);
+}